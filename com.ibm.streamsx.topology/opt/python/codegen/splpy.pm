@@ -136,6 +136,24 @@ sub typeHasBlobs {
   return 0;
 }
 
+my $listBuffers = 0; # pass numeric lists as memoryviews, see splpyListBuffers()
+
+# Check if a type is a numeric list passed to Python
+# as a memoryview of the list's storage, which is
+# only when enabled by splpyListBuffers().
+# Bounded lists are excluded.
+sub typeIsBufferList {
+  my $type = $_[0];
+
+  if ($listBuffers && SPL::CodeGen::Type::isList($type) && ($type !~ /\]$/)) {
+      my $element_type = SPL::CodeGen::Type::getElementType($type);
+      return SPL::CodeGen::Type::isSigned($element_type)
+          || SPL::CodeGen::Type::isUnsigned($element_type)
+          || SPL::CodeGen::Type::isFloat($element_type);
+  }
+  return 0;
+}
+
 #
 # Return a C++ code block converting a input attribute
 # from an SPL input tuple to a Python object and
@@ -221,7 +239,8 @@ sub splpy_inputtuple2value{
  }
  
  if ($pystyle eq 'json') {
-  return 'SPL::rstring const & value = ' . $iport->getCppTupleName() . '.get_jsonString();';
+  # Parsed before the GIL is acquired
+  return 'streamsx::topology::SplpyJSON value(' . $iport->getCppTupleName() . '.get_jsonString());';
  }
 
  if ($pystyle eq 'dict') {
@@ -233,13 +252,21 @@ sub splpy_inputtuple2value{
 
 # Starts a block that converts an SPL attribute
 # to the enclosed variable value
+#
+# If stage is set it is the name of the C++ variable
+# holding the attribute staged by stageAttributeForPython.
 sub _attr2Value {
   my $ituple = $_[0];
   my $type = $_[1];
   my $name = $_[2];
+  my $stage = $_[3];
 
   my $get = '{ PyObject * value = ';
-  $get = $get . convertAttributeToPythonValue($ituple, $type, $name);
+  if ($stage) {
+    $get = $get . $stage . '.toPyObject()';
+  } else {
+    $get = $get . convertAttributeToPythonValue($ituple, $type, $name);
+  }
   $get = $get . ";\n";
 
   # If the attribute has blobs then
@@ -249,8 +276,10 @@ sub _attr2Value {
   # if it's something containing blobs the complete collection
   # object is passed to Python for release.
   #
+  # Numeric lists passed as memoryviews are handled the same way.
+  #
   # Assumes that pyMvs exists set up by py_splTupleCheckForBlobs.cgt
-  if (typeHasBlobs($type)) {
+  if (typeHasBlobs($type) || typeIsBufferList($type)) {
       $get = $get . "PYSPL_MEMORY_VIEW(value);\n";
   }
   return $get;
@@ -265,6 +294,7 @@ sub _attr2Value {
 # type - spl type
 # name - attribute name
 # names - PyObject * pointing to Python tuple containing attribute names.
+# stage - Optional, variable holding the staged attribute
 
 sub convertAndAddToPythonDictionaryObject {
   my $ituple = $_[0];
@@ -272,9 +302,10 @@ sub convertAndAddToPythonDictionaryObject {
   my $type = $_[2];
   my $name = $_[3];
   my $names = $_[4];
+  my $stage = $_[5];
 
   # starts a C++ blockand sets value
-  my $get = _attr2Value($ituple, $type, $name);
+  my $get = _attr2Value($ituple, $type, $name, $stage);
 
   # PyTuple_GET_ITEM returns a borrowed reference.
   $getkey = 'PyObject * key = PyTuple_GET_ITEM(' . $names . ',' . $i . ");\n";
@@ -295,21 +326,66 @@ sub convertAndAddToPythonDictionaryObject {
 # type - spl type
 # name - attribute name
 # names - PyObject * pointing to Python tuple containing attribute names.
+# stage - Optional, variable holding the staged attribute
 
 sub convertAndAddToPythonTupleObject {
   my $ituple = $_[0];
   my $i = $_[1];
   my $type = $_[2];
   my $name = $_[3];
+  my $stage = $_[4];
 
   # starts a C++ blockand sets value
-  my $get = _attr2Value($ituple, $type, $name);
+  my $get = _attr2Value($ituple, $type, $name, $stage);
 
   my $settuple =  "PyTuple_SET_ITEM(pyTuple, $i, value);\n";
 
   return $get . $settuple . "}\n" ;
 }
 
+#
+# Stage an attribute of an SPL tuple for conversion to
+# Python, without holding the GIL (see SplpyStaged).
+# Declares the C++ variable stage which is then passed
+# to convertAndAddToPythonDictionaryObject or
+# convertAndAddToPythonTupleObject while holding the GIL.
+#
+# rstring attributes are staged with a string cache
+# (SplpyStringCache) declared static so that it is
+# shared across tuples processed by the operator,
+# only when executing in the main interpreter.
+#
+# Numeric lists are staged as memoryviews (SplpyStagedBuffer)
+# when enabled by splpyListBuffers().
+#
+# ituple - C++ expression of the tuple
+# attr - Input port attribute
+# stage - Name of the C++ variable to declare
+#
+sub stageAttributeForPython {
+  my $ituple = $_[0];
+  my $attr = $_[1];
+  my $stage = $_[2];
+
+  # Check the type is supported
+  splToPythonConversionCheck($attr->getSPLType());
+
+  if (typeIsBufferList($attr->getSPLType())) {
+      return 'streamsx::topology::SplpyStagedBuffer<' . $attr->getCppType() . ' > ' .
+          $stage . '(' . $ituple . '.get_' . $attr->getName() . "());\n";
+  }
+
+  my $decl = '';
+  my $cache = '';
+  if (SPL::CodeGen::Type::isRString($attr->getSPLType())) {
+      $decl = 'static streamsx::topology::SplpyStringCache ' . $stage . "Cache;\n";
+      $cache = ', streamsx::topology::SplpyStringCache::main(' . $stage . 'Cache)';
+  }
+
+  return $decl . 'streamsx::topology::SplpyStaged<' . $attr->getCppType() . ' > ' .
+      $stage . '(' . $ituple . '.get_' . $attr->getName() . '()' . $cache . ");\n";
+}
+
 ## Execute pip to install packages in the
 ## applications output directory under
 ## /etc/streamsx.topology/python
@@ -391,6 +467,14 @@ sub splpyInit {
     ($model) = @_;
 }
 
+#
+# Pass numeric list attributes of input tuples
+# to Python as memoryviews rather than lists.
+#
+sub splpyListBuffers {
+    ($listBuffers) = @_;
+}
+
 #
 # Return true if optional data types are supported, else false.
 #
@@ -20,6 +20,7 @@
 #include "splpy_setup.h"
 #include "splpy_tuple.h"
 #include "splpy_op.h"
+#include "splpy_view.h"
 
 #include <string>
 #include <sys/types.h>
@@ -119,15 +120,41 @@ namespace streamsx {
       return pyReturnVar;
     }
 
+    /*
+    * Call a function passing the SPL attribute value of type T
+    * and set the SPL rstring attribute to the JSON serialization
+    * of its result. Implementation for Map operator with a
+    * JSON (CommonSchema.Json) output port.
+    */
+    template <class T>
+    static int pyTupleMapJSON(PyObject * function, T & splVal, SPL::rstring & retSplVal) {
+      SplpyGIL lock;
+
+      // invoke python nested function that calls the application function
+      PyObject * pyReturnVar = pyTupleMap(function, splVal);
+
+      if (pyReturnVar == NULL)
+          return 0;
+
+      pySplJSONFromPyObject(retSplVal, pyReturnVar);
+      Py_DECREF(pyReturnVar);
+
+      return 1;
+    }
+
     /**
      * Implementation for Map operator when the output port
      * can pass by reference.
      * occ = 0,-1 do not pass by ref
      * occ >= 1 - pass by ref - occ is the reference count bumps
      * we must leave the object with.
+     * When not passing by ref the returned object is encoded
+     * by codec if it is not NULL, otherwise the pickled value
+     * is passed through shm if it is not NULL.
      */
     template <class T>
-    static int pyTupleMapByRef(PyObject * function, T & splVal, SPL::blob & retSplVal, int32_t occ) {
+    static int pyTupleMapByRef(PyObject * function, T & splVal, SPL::blob & retSplVal, int32_t occ,
+           SplpyShmArena * shm = NULL, SplpyCodec * codec = NULL) {
       SplpyGIL lock;
 
       // invoke python nested function that calls the application function
@@ -141,7 +168,10 @@ namespace streamsx {
           return 1;
       } 
 
-      pySplValueFromPyObject(retSplVal, pyReturnVar);
+      if (codec != NULL)
+          pySplValueEncode(retSplVal, pyReturnVar, codec);
+      else
+          pySplValueFromPyObject(retSplVal, pyReturnVar, shm);
       Py_DECREF(pyReturnVar);
 
       return 1;
@@ -180,6 +210,16 @@ namespace streamsx {
        PyObject * pyNames = PyTuple_New(ac);
        for (uint32_t i = 0; i < ac; i++) {
             PyObject * pyName = pyUnicode_FromUTF8(tt.getAttributeName(i));
+#if PY_MAJOR_VERSION == 3
+            // Interned so that a lookup using a literal
+            // attribute name from Python code is an
+            // identity comparison.
+            PyUnicode_InternInPlace(&pyName);
+#endif
+            // Compute the hash now so that it is cached
+            // in the name, rather than computed each time
+            // a dict is built for a tuple using the names.
+            PyObject_Hash(pyName);
             PyTuple_SET_ITEM(pyNames, i, pyName);
        }
        return pyNames;
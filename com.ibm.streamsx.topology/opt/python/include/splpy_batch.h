@@ -0,0 +1,267 @@
+/*
+# Licensed Materials - Property of IBM
+# Copyright IBM Corp. 2018
+*/
+
+/*
+ * Internal header file supporting Python
+ * for com.ibm.streamsx.topology.
+ *
+ * This is not part of any public api for
+ * the toolkit or toolkit with decorated
+ * SPL Python operators.
+ *
+ * Functionality related to invoking a functional
+ * operator's callable for a batch of tuples.
+ */
+
+#ifndef __SPL__SPLPY_BATCH_H
+#define __SPL__SPLPY_BATCH_H
+
+#include <time.h>
+
+#include "splpy_general.h"
+#include "splpy_op.h"
+
+namespace streamsx {
+  namespace topology {
+
+/**
+ * Accumulates the arguments for the callable of a functional
+ * operator across a number of SPL tuples so that the callable
+ * is invoked for all of them holding the GIL once, rather than
+ * once per tuple.
+ *
+ * Each entry is the Python tuple of arguments the operator would
+ * pass to its wrapped callable for a single SPL tuple
+ * (see pySplBatchArgs).
+ *
+ * A batch is complete when it contains size entries or when
+ * linger seconds have passed since its first entry was added.
+ *
+ * The operator must synchronize access to the batch, and
+ * the GIL must be held for add(), take() and clear().
+ */
+class SplpyBatch {
+  public:
+    SplpyBatch(int32_t size, double linger) :
+        size_(size), linger_(linger), args_(NULL), deadline_(0.0)
+    {
+    }
+
+    ~SplpyBatch() {
+        // Any pending arguments must have been
+        // released through clear() holding the GIL.
+    }
+
+    /**
+     * Maximum number of entries in a batch.
+     */
+    int32_t size() const {
+        return size_;
+    }
+
+    /**
+     * Maximum time in seconds an entry is held, zero means
+     * a batch is only completed by size or punctuation.
+     */
+    double linger() const {
+        return linger_;
+    }
+
+    bool empty() const {
+        return args_ == NULL;
+    }
+
+    /**
+     * Add the arguments for a tuple to the batch,
+     * stealing the reference to args.
+     * Returns true if the batch is now full.
+     */
+    bool add(PyObject * args) {
+        if (args_ == NULL) {
+            args_ = PyList_New(0);
+            if (args_ == NULL) {
+                Py_DECREF(args);
+                throw SplpyGeneral::pythonException("batch");
+            }
+            if (linger_ > 0.0)
+                deadline_ = now() + linger_;
+        }
+        int rc = PyList_Append(args_, args);
+        Py_DECREF(args);
+        if (rc != 0)
+            throw SplpyGeneral::pythonException("batch");
+
+        return PyList_GET_SIZE(args_) >= size_;
+    }
+
+    /**
+     * Seconds until the linger time of the current batch
+     * passes, zero or negative once it has passed.
+     * Returns the linger time for an empty batch.
+     */
+    double remaining() const {
+        if (args_ == NULL)
+            return linger_;
+        return deadline_ - now();
+    }
+
+    /**
+     * Take the current batch as a list of argument
+     * tuples (new reference) leaving this batch empty.
+     * Returns NULL if the batch is empty.
+     */
+    PyObject * take() {
+        PyObject * args = args_;
+        args_ = NULL;
+        return args;
+    }
+
+    /**
+     * Discard any pending entries.
+     */
+    void clear() {
+        Py_CLEAR(args_);
+    }
+
+    /**
+     * Call the wrapped callable for every set of arguments in
+     * batch, returning a list (new reference) of the values
+     * returned by each call in order.
+     *
+     * A tuple whose call raised an exception suppressed
+     * by the application's __exit__ method has None as
+     * its return, so that it produces no output.
+     *
+     * When workers is not NULL the callable is invoked in
+     * the pool of worker processes (see SplpyFuncOp::workers()).
+     *
+     * Caller must hold the GIL.
+     */
+    static PyObject * call(SplpyOp * op, PyObject * batch, PyObject * workers = NULL) {
+        static PyObject * callBatch = NULL;
+        static PyObject * callWorkers = NULL;
+        PyObject * function = workers == NULL ?
+            SplpyGeneral::cachedFunction(callBatch,
+               "streamsx.topology.runtime", "_call_batch") :
+            SplpyGeneral::cachedFunction(callWorkers,
+               "streamsx.topology.runtime", "_call_workers");
+
+        PyObject * rvs = PyList_New(0);
+        if (rvs == NULL)
+            throw SplpyGeneral::pythonException("batch");
+
+        PyObject * none = SplpyGeneral::getNone(NULL);
+        invoke(op, workers, function, batch, rvs, none);
+        Py_DECREF(none);
+        return rvs;
+    }
+
+    /**
+     * Call the wrapped predicate for every set of arguments
+     * in batch, returning a selection mask (new reference)
+     * holding one byte per tuple in order, non-zero when
+     * the predicate returned a true value.
+     *
+     * The mask supports the buffer protocol, see SplpyBuffer.
+     * A tuple whose call raised an exception suppressed
+     * by the application's __exit__ method is not selected.
+     *
+     * When workers is not NULL the predicate is invoked in
+     * the pool of worker processes.
+     *
+     * Caller must hold the GIL.
+     */
+    static PyObject * filter(SplpyOp * op, PyObject * batch, PyObject * workers = NULL) {
+        static PyObject * filterBatch = NULL;
+        static PyObject * filterWorkers = NULL;
+        PyObject * function = workers == NULL ?
+            SplpyGeneral::cachedFunction(filterBatch,
+               "streamsx.topology.runtime", "_filter_batch") :
+            SplpyGeneral::cachedFunction(filterWorkers,
+               "streamsx.topology.runtime", "_filter_workers");
+
+        PyObject * mask = PyByteArray_FromStringAndSize(NULL, 0);
+        if (mask == NULL)
+            throw SplpyGeneral::pythonException("batch");
+
+        PyObject * zero = PyLong_FromLong(0);
+        invoke(op, workers, function, batch, mask, zero);
+        Py_DECREF(zero);
+        return mask;
+    }
+
+  private:
+    /**
+     * Call fn(callable, batch, rvs) where fn appends the result for
+     * each tuple to rvs starting at the arguments at index len(rvs).
+     * The worker pool is passed in place of the callable when
+     * workers is not NULL.
+     *
+     * If a call raises an exception it is passed to the
+     * operator (and thus the application's __exit__ method).
+     * If the exception is suppressed skip is appended as the
+     * result for the failing tuple and the remainder of the batch
+     * continues, otherwise the SPL exception for the Python error
+     * is thrown, releasing rvs.
+     */
+    static void invoke(SplpyOp * op, PyObject * workers, PyObject * fn,
+           PyObject * batch, PyObject * rvs, PyObject * skip) {
+
+        PyObject * target = workers == NULL ? op->callable() : workers;
+        const Py_ssize_t n = PyList_GET_SIZE(batch);
+        while (PyObject_Size(rvs) < n) {
+            PyObject * args = PyTuple_New(3);
+            Py_INCREF(target);
+            PyTuple_SET_ITEM(args, 0, target);
+            Py_INCREF(batch);
+            PyTuple_SET_ITEM(args, 1, batch);
+            Py_INCREF(rvs);
+            PyTuple_SET_ITEM(args, 2, rvs);
+
+            PyObject * ret = PyObject_CallObject(fn, args);
+            Py_DECREF(args);
+            if (ret != NULL) {
+                Py_DECREF(ret);
+                break;
+            }
+
+            SplpyExceptionInfo excInfo = SplpyExceptionInfo::pythonError("batch");
+            if (op->exceptionRaised(excInfo) == 0) {
+                Py_DECREF(rvs);
+                throw excInfo.exception();
+            }
+            excInfo.clear();
+
+            // Exception suppressed, the tuple that
+            // raised it produces no output.
+            PyObject * append = PyObject_GetAttrString(rvs, "append");
+            PyObject * skipArgs = PyTuple_New(1);
+            Py_INCREF(skip);
+            PyTuple_SET_ITEM(skipArgs, 0, skip);
+            ret = SplpyGeneral::pyCallObject(append, skipArgs);
+            Py_DECREF(append);
+            Py_DECREF(ret);
+        }
+    }
+
+    static double now() {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return ts.tv_sec + (ts.tv_nsec / 1e9);
+    }
+
+    const int32_t size_;
+    const double linger_;
+
+    // List of argument tuples, NULL when empty.
+    PyObject * args_;
+
+    // Time the current batch must be completed by.
+    double deadline_;
+};
+
+}}
+
+#endif
@@ -0,0 +1,481 @@
+/*
+# Licensed Materials - Property of IBM
+# Copyright IBM Corp. 2018
+*/
+
+/*
+ * Internal header file supporting Python
+ * for com.ibm.streamsx.topology.
+ *
+ * This is not part of any public api for
+ * the toolkit or toolkit with decorated
+ * SPL Python operators.
+ *
+ * Functionality related to encoding Python objects
+ * on streams with a codec instead of pickle.
+ */
+
+#ifndef __SPL__SPLPY_CODEC_H
+#define __SPL__SPLPY_CODEC_H
+
+#include <string.h>
+#include <string>
+
+#include "splpy_general.h"
+
+/**
+ * Marker for a SPL blob containing a Python object
+ * encoded by a codec, followed by the codec's
+ * identifier and the encoded value.
+ */
+#define STREAMSX_TPP_CODEC ((unsigned char) 0x87)
+
+namespace streamsx {
+  namespace topology {
+
+/**
+ * Codec encoding Python objects into a blob without
+ * calling into the pickle machinery.
+ *
+ * A codec only supports a set of types, any value it cannot
+ * encode is pickled (see pySplValueEncode).
+ *
+ * Codecs are registered by name (selected by the pyCodec
+ * operator parameter) and by an identifier carried in
+ * each blob, so that a consumer decodes any registered codec.
+ *
+ * Codec instances are shared, the caller must hold the GIL.
+ */
+class SplpyCodec {
+  public:
+    virtual ~SplpyCodec() {}
+
+    /**
+     * Return the codec for a name. If no such codec
+     * is registered values are pickled.
+     */
+    static SplpyCodec * find(const std::string & name);
+
+    /**
+     * Encode value into the blob.
+     * Returns false leaving the blob unmodified
+     * if the codec does not support the value.
+     */
+    bool encode(SPL::blob & splv, PyObject * value) {
+        buf_.resize(2);
+        buf_[0] = (char) STREAMSX_TPP_CODEC;
+        buf_[1] = (char) id_;
+        if (!encodeValue(value, 0))
+            return false;
+        splv.setData((const unsigned char *) buf_.data(), buf_.size());
+        return true;
+    }
+
+    /**
+     * Decode a blob marked STREAMSX_TPP_CODEC
+     * returning a new reference.
+     */
+    static PyObject * decode(const SPL::blob & pyo);
+
+  protected:
+    SplpyCodec(unsigned char id) : id_(id) {}
+
+    // Append value to buf_, returning false if it is not supported.
+    virtual bool encodeValue(PyObject * value, int depth) = 0;
+
+    // Decode a value returning a new reference or NULL.
+    virtual PyObject * decodeValue(const unsigned char * data, size_t size) = 0;
+
+    const unsigned char id_;
+    std::string buf_;
+};
+
+#if PY_MAJOR_VERSION == 3
+/**
+ * Codec using the MessagePack format for None, bool, int
+ * (within 64 bits), float, str, bytes, list, tuple and dict.
+ *
+ * Exact types only, e.g. a subclass of dict is pickled.
+ * A tuple is encoded as extension type 1 wrapping an array
+ * so that it is decoded as a tuple.
+ */
+class SplpyMsgPackCodec : public SplpyCodec {
+  public:
+    static const unsigned char ID = 1;
+    // Values with deeper nesting of lists, tuples
+    // and dicts are pickled. Only containers count
+    // towards the depth, the same when decoding.
+    static const int MAX_DEPTH = 256;
+
+    SplpyMsgPackCodec() : SplpyCodec(ID) {
+        PyObject * v;
+        none_ = Py_TYPE(v = SplpyGeneral::getNone(NULL)); Py_DECREF(v);
+        bool_ = Py_TYPE(v = PyBool_FromLong(1)); Py_DECREF(v);
+        int_ = Py_TYPE(v = PyLong_FromLong(0)); Py_DECREF(v);
+        float_ = Py_TYPE(v = PyFloat_FromDouble(0.0)); Py_DECREF(v);
+        str_ = Py_TYPE(v = PyUnicode_DecodeUTF8("", 0, NULL)); Py_DECREF(v);
+        bytes_ = Py_TYPE(v = PyBytes_FromStringAndSize("", 0)); Py_DECREF(v);
+        list_ = Py_TYPE(v = PyList_New(0)); Py_DECREF(v);
+        tuple_ = Py_TYPE(v = PyTuple_New(0)); Py_DECREF(v);
+        dict_ = Py_TYPE(v = PyDict_New()); Py_DECREF(v);
+    }
+
+  protected:
+    bool encodeValue(PyObject * value, int depth) {
+        PyTypeObject * type = Py_TYPE(value);
+        if (type == str_) {
+            Py_ssize_t size;
+            const char * utf8 = PyUnicode_AsUTF8AndSize(value, &size);
+            if (utf8 == NULL) {
+                PyErr_Clear();
+                return false;
+            }
+            header(size, 0xa0, 32, 0xd9, 0xda, 0xdb);
+            buf_.append(utf8, size);
+            return true;
+        }
+        if (type == int_) {
+            long v = PyLong_AsLong(value);
+            if (v == -1 && PyErr_Occurred()) {
+                PyErr_Clear();
+                unsigned long uv = PyLong_AsUnsignedLong(value);
+                if (uv == (unsigned long) -1 && PyErr_Occurred()) {
+                    PyErr_Clear();
+                    return false;
+                }
+                put(0xcf);
+                putBE(uv, 8);
+                return true;
+            }
+            if (v >= 0) {
+                if (v < 128) put(v);
+                else if (v < 256) { put(0xcc); putBE(v, 1); }
+                else if (v < 65536) { put(0xcd); putBE(v, 2); }
+                else if (v <= 0xFFFFFFFFL) { put(0xce); putBE(v, 4); }
+                else { put(0xcf); putBE(v, 8); }
+            } else {
+                if (v >= -32) put(v & 0xff);
+                else if (v >= -128) { put(0xd0); putBE(v, 1); }
+                else if (v >= -32768) { put(0xd1); putBE(v, 2); }
+                else if (v >= -2147483648L) { put(0xd2); putBE(v, 4); }
+                else { put(0xd3); putBE(v, 8); }
+            }
+            return true;
+        }
+        if (type == float_) {
+            double d = PyFloat_AsDouble(value);
+            uint64_t bits;
+            memcpy(&bits, &d, sizeof(bits));
+            put(0xcb);
+            putBE(bits, 8);
+            return true;
+        }
+        if (type == none_) {
+            put(0xc0);
+            return true;
+        }
+        if (type == bool_) {
+            put(PyObject_IsTrue(value) ? 0xc3 : 0xc2);
+            return true;
+        }
+        if (type == bytes_) {
+            const Py_ssize_t size = PyBytes_GET_SIZE(value);
+            header(size, 0, 0, 0xc4, 0xc5, 0xc6);
+            buf_.append(PyBytes_AsString(value), size);
+            return true;
+        }
+        if (type != dict_ && type != list_ && type != tuple_)
+            return false;
+        if (++depth > MAX_DEPTH)
+            return false;
+        if (type == dict_) {
+            header(PyDict_Size(value), 0x80, 16, 0, 0xde, 0xdf);
+            Py_ssize_t pos = 0;
+            PyObject * k;
+            PyObject * v;
+            while (PyDict_Next(value, &pos, &k, &v)) {
+                if (!encodeValue(k, depth) || !encodeValue(v, depth))
+                    return false;
+            }
+            return true;
+        }
+        if (type == list_) {
+            const Py_ssize_t n = PyList_GET_SIZE(value);
+            header(n, 0x90, 16, 0, 0xdc, 0xdd);
+            for (Py_ssize_t i = 0; i < n; i++) {
+                if (!encodeValue(PyList_GET_ITEM(value, i), depth))
+                    return false;
+            }
+            return true;
+        }
+        if (type == tuple_) {
+            // ext 32 with the length set once the array is encoded.
+            put(0xc9);
+            const size_t lenAt = buf_.size();
+            putBE(0, 4);
+            put(TUPLE_EXT);
+            const size_t start = buf_.size();
+            const Py_ssize_t n = PyTuple_GET_SIZE(value);
+            header(n, 0x90, 16, 0, 0xdc, 0xdd);
+            for (Py_ssize_t i = 0; i < n; i++) {
+                if (!encodeValue(PyTuple_GET_ITEM(value, i), depth))
+                    return false;
+            }
+            const uint64_t len = buf_.size() - start;
+            for (int i = 0; i < 4; i++)
+                buf_[lenAt + i] = (char) (len >> (8 * (3 - i)));
+            return true;
+        }
+        return false;
+    }
+
+    PyObject * decodeValue(const unsigned char * data, size_t size) {
+        const unsigned char * end = data + size;
+        PyObject * value = decodeNext(data, end, 0);
+        if (value != NULL && data != end) {
+            Py_DECREF(value);
+            return NULL;
+        }
+        return value;
+    }
+
+  private:
+    static const unsigned char TUPLE_EXT = 1;
+
+    void put(long c) {
+        buf_.push_back((char) c);
+    }
+    void putBE(uint64_t v, int n) {
+        for (int i = n - 1; i >= 0; i--)
+            buf_.push_back((char) (v >> (8 * i)));
+    }
+
+    // Type header for a length, using the fix format
+    // if fixbase is non-zero and length < fixmax.
+    void header(uint64_t len, int fixbase, uint64_t fixmax, int t8, int t16, int t32) {
+        if (fixbase != 0 && len < fixmax) put(fixbase | len);
+        else if (t8 != 0 && len < 256) { put(t8); putBE(len, 1); }
+        else if (len < 65536) { put(t16); putBE(len, 2); }
+        else { put(t32); putBE(len, 4); }
+    }
+
+    static bool getBE(const unsigned char * & p, const unsigned char * end, int n, uint64_t & v) {
+        if (end - p < n)
+            return false;
+        v = 0;
+        for (int i = 0; i < n; i++)
+            v = (v << 8) | *p++;
+        return true;
+    }
+
+    PyObject * decodeNext(const unsigned char * & p, const unsigned char * end, int depth) {
+        if (p >= end)
+            return NULL;
+        const unsigned char t = *p++;
+        uint64_t v;
+
+        if (t <= 0x7f)
+            return PyLong_FromLong(t);
+        if (t >= 0xe0)
+            return PyLong_FromLong((signed char) t);
+        if ((t & 0xe0) == 0xa0)
+            return decodeStr(p, end, t & 0x1f);
+        if ((t & 0xf0) == 0x90)
+            return decodeList(p, end, t & 0x0f, depth);
+        if ((t & 0xf0) == 0x80)
+            return decodeDict(p, end, t & 0x0f, depth);
+
+        switch (t) {
+        case 0xc0: return SplpyGeneral::getNone(NULL);
+        case 0xc2: return PyBool_FromLong(0);
+        case 0xc3: return PyBool_FromLong(1);
+        case 0xcc: case 0xcd: case 0xce: case 0xcf:
+            if (!getBE(p, end, 1 << (t - 0xcc), v))
+                return NULL;
+            return PyLong_FromUnsignedLong(v);
+        case 0xd0: case 0xd1: case 0xd2: case 0xd3: {
+            const int n = 1 << (t - 0xd0);
+            if (!getBE(p, end, n, v))
+                return NULL;
+            // sign extend
+            if (n < 8 && (v & (((uint64_t) 1) << (8 * n - 1))))
+                v |= ~((((uint64_t) 1) << (8 * n)) - 1);
+            return PyLong_FromLong((long) (int64_t) v);
+        }
+        case 0xcb: {
+            if (!getBE(p, end, 8, v))
+                return NULL;
+            double d;
+            memcpy(&d, &v, sizeof(d));
+            return PyFloat_FromDouble(d);
+        }
+        case 0xd9: case 0xda: case 0xdb:
+            if (!getBE(p, end, 1 << (t - 0xd9), v))
+                return NULL;
+            return decodeStr(p, end, v);
+        case 0xc4: case 0xc5: case 0xc6:
+            if (!getBE(p, end, 1 << (t - 0xc4), v) || (uint64_t) (end - p) < v)
+                return NULL;
+            p += v;
+            return PyBytes_FromStringAndSize((const char *) (p - v), v);
+        case 0xdc: case 0xdd:
+            if (!getBE(p, end, t == 0xdc ? 2 : 4, v))
+                return NULL;
+            return decodeList(p, end, v, depth);
+        case 0xde: case 0xdf:
+            if (!getBE(p, end, t == 0xde ? 2 : 4, v))
+                return NULL;
+            return decodeDict(p, end, v, depth);
+        case 0xc9: {
+            if (!getBE(p, end, 4, v) || (uint64_t) (end - p) < v + 1 || *p++ != TUPLE_EXT)
+                return NULL;
+            // The wrapped array is the container, the
+            // extension does not add to the depth.
+            const unsigned char * ext = p + v;
+            PyObject * list = decodeNext(p, ext, depth);
+            if (list == NULL || p != ext || Py_TYPE(list) != list_) {
+                Py_XDECREF(list);
+                return NULL;
+            }
+            const Py_ssize_t n = PyList_GET_SIZE(list);
+            PyObject * tuple = PyTuple_New(n);
+            for (Py_ssize_t i = 0; i < n; i++) {
+                PyObject * item = PyList_GET_ITEM(list, i);
+                Py_INCREF(item);
+                PyTuple_SET_ITEM(tuple, i, item);
+            }
+            Py_DECREF(list);
+            return tuple;
+        }
+        }
+        return NULL;
+    }
+
+    PyObject * decodeStr(const unsigned char * & p, const unsigned char * end, uint64_t len) {
+        if ((uint64_t) (end - p) < len)
+            return NULL;
+        p += len;
+        return PyUnicode_DecodeUTF8((const char *) (p - len), len, NULL);
+    }
+
+    PyObject * decodeList(const unsigned char * & p, const unsigned char * end, uint64_t n, int depth) {
+        // Each item is at least one byte
+        if (++depth > MAX_DEPTH || (uint64_t) (end - p) < n)
+            return NULL;
+        PyObject * list = PyList_New(n);
+        for (uint64_t i = 0; i < n; i++) {
+            PyObject * item = decodeNext(p, end, depth);
+            if (item == NULL) {
+                Py_DECREF(list);
+                return NULL;
+            }
+            PyList_SET_ITEM(list, i, item);
+        }
+        return list;
+    }
+
+    PyObject * decodeDict(const unsigned char * & p, const unsigned char * end, uint64_t n, int depth) {
+        if (++depth > MAX_DEPTH || (uint64_t) (end - p) < 2 * n)
+            return NULL;
+        PyObject * dict = _PyDict_NewPresized(n);
+        for (uint64_t i = 0; i < n; i++) {
+            PyObject * k = decodeNext(p, end, depth);
+            PyObject * v = k == NULL ? NULL : decodeNext(p, end, depth);
+            if (v == NULL || PyDict_SetItem(dict, k, v) != 0) {
+                Py_XDECREF(k);
+                Py_XDECREF(v);
+                Py_DECREF(dict);
+                return NULL;
+            }
+            Py_DECREF(k);
+            Py_DECREF(v);
+        }
+        return dict;
+    }
+
+    PyTypeObject * none_;
+    PyTypeObject * bool_;
+    PyTypeObject * int_;
+    PyTypeObject * float_;
+    PyTypeObject * str_;
+    PyTypeObject * bytes_;
+    PyTypeObject * list_;
+    PyTypeObject * tuple_;
+    PyTypeObject * dict_;
+};
+#endif
+
+/**
+ * Codec that does not support any value,
+ * used when a codec is not supported.
+ */
+class SplpyPickleCodec : public SplpyCodec {
+  public:
+    SplpyPickleCodec() : SplpyCodec(0) {}
+  protected:
+    bool encodeValue(PyObject *, int) {
+        return false;
+    }
+    PyObject * decodeValue(const unsigned char *, size_t) {
+        return NULL;
+    }
+};
+
+/*
+ * Registry of codecs, caller must hold the GIL.
+ */
+inline SplpyCodec * SplpyCodec::find(const std::string & name) {
+#if PY_MAJOR_VERSION == 3
+    if (name == "msgpack") {
+        static SplpyMsgPackCodec msgpack;
+        return &msgpack;
+    }
+#endif
+    SPLAPPTRC(L_WARN, "Python codec not supported: " << name << ", values are pickled.", "python");
+    static SplpyPickleCodec pickle;
+    return &pickle;
+}
+
+inline PyObject * SplpyCodec::decode(const SPL::blob & pyo) {
+    const unsigned char * data = pyo.getData();
+    const uint64_t size = pyo.getSize();
+
+    SplpyCodec * codec = NULL;
+#if PY_MAJOR_VERSION == 3
+    if (size >= 2 && data[1] == SplpyMsgPackCodec::ID)
+        codec = find("msgpack");
+#endif
+    PyObject * value = codec == NULL ? NULL : codec->decodeValue(data + 2, size - 2);
+    if (value == NULL) {
+        if (PyErr_Occurred())
+            throw SplpyExceptionInfo::pythonError("decode");
+        throw SPL::SPLRuntimeDeserializationException("SplpyCodec", "Invalid blob");
+    }
+    return value;
+}
+
+/**
+ * Set the blob to a Python object encoded by the codec,
+ * or pickled if the codec does not support the value.
+ * Does not steal the reference to value.
+ */
+inline void pySplValueEncode(SPL::blob & splv, PyObject * value, SplpyCodec * codec) {
+    if (codec->encode(splv, value))
+        return;
+
+    static PyObject * dumps = NULL;
+    PyObject * function = SplpyGeneral::cachedFunction(dumps, "streamsx.topology.runtime", "_pickle_dumps");
+    PyObject * args = PyTuple_New(1);
+    Py_INCREF(value);
+    PyTuple_SET_ITEM(args, 0, value);
+    PyObject * pv = PyObject_CallObject(function, args);
+    Py_DECREF(args);
+    if (pv == NULL)
+        throw SplpyExceptionInfo::pythonError("pickle");
+    pySplValueFromPyObject(splv, pv);
+    Py_DECREF(pv);
+}
+
+}}
+
+#endif
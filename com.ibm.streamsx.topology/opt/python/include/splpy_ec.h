@@ -388,8 +388,9 @@ static struct PyModuleDef __splpy_ec_module = {
    PyModuleDef_HEAD_INIT,
    __SPLPY_EC_MODULE_NAME,   /* name of module */
    "Internal module providing access to the Streams execution environment.",
-   -1,       /* size of per-interpreter state of the module,
-                or -1 if the module keeps state in global variables. */
+   0,        /* size of per-interpreter state of the module,
+                the module has no state so each interpreter
+                initializes its own instance. */
    __splpy_ec_methods
 };
 #endif
@@ -29,14 +29,49 @@ class SplpyFuncOp : public SplpyOp {
   public:
 
       SplpyFuncOp(SPL::Operator * op, const std::string & wrapfn) :
-        SplpyOp(op, "/opt/python/packages/streamsx/topology")
+        SplpyOp(op, "/opt/python/packages/streamsx/topology",
+            subinterpreter(op)),
+        workers_(NULL)
       {
+         SplpyInterpreter::Scope scope(interpreter());
          setSubmissionParameters();
          addAppPythonPackages();
          loadAndWrapCallable(wrapfn);
+         if (hasParam("workers"))
+             startWorkers(wrapfn);
+      }
+
+      ~SplpyFuncOp() {
+         closeWorkers();
+      }
+
+      /**
+       * Pool of worker Python processes the callable is invoked
+       * in for batches of tuples when the workers parameter is set
+       * (streamsx.topology.runtime._WorkerPool), otherwise NULL.
+       */
+      PyObject * workers() {
+          return workers_;
+      }
+
+      /**
+       * Actions on prepareToShutdown, the worker processes
+       * are shut down before the operator's callable.
+       */
+      void prepareToShutdown() {
+          closeWorkers();
+          SplpyOp::prepareToShutdown();
       }
       
   private:
+      /**
+       * Does the operator execute in its own sub-interpreter.
+       */
+      static bool subinterpreter(SPL::Operator * op) {
+          return op->getParameterNames().count("subinterpreter") != 0 &&
+              static_cast<SPL::boolean>(op->getParameterValues("subinterpreter")[0]->getValue());
+      }
+
       int hasParam(const char *name) {
           return op()->getParameterNames().count(name);
       }
@@ -107,9 +142,51 @@ class SplpyFuncOp : public SplpyOp {
                "streamsx.topology.runtime", wrapfn, appCallable, extraArg));
       }
 
+      /**
+       * Start the worker processes, each loads and wraps
+       * the callable as loadAndWrapCallable does.
+       */
+      void startWorkers(const std::string & wrapfn) {
+          SplpyGIL lock;
+
+          PyObject * args = PyTuple_New(6);
+          PyTuple_SET_ITEM(args, 0, PyLong_FromLong(
+              static_cast<SPL::int32>(op()->getParameterValues("workers")[0]->getValue())));
+          PyTuple_SET_ITEM(args, 1, pyUnicode_FromUTF8(param("pyModule")));
+          PyTuple_SET_ITEM(args, 2, pyUnicode_FromUTF8(param("pyName")));
+          PyTuple_SET_ITEM(args, 3, hasParam("pyCallable") ?
+              pyUnicode_FromUTF8(param("pyCallable")) : SplpyGeneral::getNone(NULL));
+          PyTuple_SET_ITEM(args, 4, pyUnicode_FromUTF8(wrapfn));
+          PyTuple_SET_ITEM(args, 5, op()->getNumberOfOutputPorts() == 1 ?
+              Splpy::pyAttributeNames(op()->getOutputPortAt(0)) : SplpyGeneral::getNone(NULL));
+
+          PyObject * pool = SplpyGeneral::loadFunction(
+              "streamsx.topology.runtime", "_WorkerPool");
+          workers_ = SplpyGeneral::pyCallObject(pool, args);
+          Py_DECREF(pool);
+      }
+
+      /**
+       * Shut down the worker processes, callable
+       * invocations then execute in this process.
+       */
+      void closeWorkers() {
+          SplpyInterpreter::Scope scope(interpreter());
+          SplpyGIL lock;
+          if (workers_ != NULL) {
+              PyObject * workers = workers_;
+              workers_ = NULL;
+              // steals the reference to workers
+              SplpyGeneral::callVoidFunction(
+                  "streamsx.topology.runtime", "_close_workers", workers, NULL);
+          }
+      }
+
       virtual bool isStateful() {
         return static_cast<SPL::boolean>(op()->getParameterValues("pyStateful")[0]->getValue());
       }
+
+      PyObject * workers_;
  
       /*
        *  Add any packages in the application directory
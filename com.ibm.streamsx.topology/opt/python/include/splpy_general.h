@@ -19,7 +19,17 @@
 #define __SPL__SPLPY_GENERAL_H
 
 #include "Python.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
 #include <sstream>
+#include <map>
+#include <vector>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 #undef PyMemoryView_Check
 #define PyMemoryView_Check(o) SplpyGeneral::checkMemoryView(o)
@@ -52,6 +62,115 @@ namespace streamsx {
     }
 
 
+    /*
+    ** Encode a string's code units as UTF-8 directly into
+    ** an rstring, avoiding any intermediate Python object.
+    ** Returns false without modifying attr if the string
+    ** contains a surrogate code unit, such strings are
+    ** left to Python's encoder for its handling of them.
+    */
+    template <typename C>
+    inline bool _pySplRStringFromCodeUnits(SPL::rstring & attr, const C * s, Py_ssize_t len) {
+
+      // Sizing pass is branch free so that the compiler
+      // can vectorize it.
+      size_t size = len;
+      unsigned int surrogates = 0;
+      for (Py_ssize_t i = 0; i < len; i++) {
+          const uint32_t c = s[i];
+          size += (c >= 0x80) + (c >= 0x800) + (c >= 0x10000);
+          surrogates |= (c - 0xD800) < 0x800;
+      }
+      if (surrogates)
+          return false;
+
+      attr.resize(size);
+      unsigned char * out = (unsigned char *) &attr[0];
+      for (Py_ssize_t i = 0; i < len; ) {
+          const uint32_t c = s[i++];
+          if (c < 0x80) {
+              *out++ = c;
+          } else if (c < 0x800) {
+              *out++ = 0xC0 | (c >> 6);
+              *out++ = 0x80 | (c & 0x3F);
+          } else if (c < 0x10000) {
+              *out++ = 0xE0 | (c >> 12);
+              *out++ = 0x80 | ((c >> 6) & 0x3F);
+              *out++ = 0x80 | (c & 0x3F);
+          } else {
+              *out++ = 0xF0 | (c >> 18);
+              *out++ = 0x80 | ((c >> 12) & 0x3F);
+              *out++ = 0x80 | ((c >> 6) & 0x3F);
+              *out++ = 0x80 | (c & 0x3F);
+          }
+      }
+      return true;
+    }
+
+    /*
+    ** Direct conversion of strings is used unless the
+    ** environment variable STREAMSX_PYTHON_DIRECT_STRINGS
+    ** is set to 0, allowing its performance to be compared
+    ** with Python's conversion (see test2_perf_strings.py).
+    */
+    inline bool _pySplDirectStrings() {
+      const char * value = getenv("STREAMSX_PYTHON_DIRECT_STRINGS");
+      return value == NULL || strcmp(value, "0") != 0;
+    }
+
+    /*
+    ** Convert a Python unicode object to an SPL rstring
+    ** without creating any Python objects.
+    ** Returns false if the conversion must be done by Python.
+    **
+    ** Encoding directly avoids creating an intermediate
+    ** object which dominates the cost for short strings,
+    ** Python's own encoder is faster for longer non-ASCII strings.
+    */
+    inline bool _pySplRStringFromUnicode(SPL::rstring & attr, PyObject * value) {
+      static const bool direct = _pySplDirectStrings();
+      if (!direct)
+          return false;
+      const Py_ssize_t directMax = 64;
+#if PY_MAJOR_VERSION == 3
+      if (!PyUnicode_IS_READY(value))
+          return false;
+
+      // ASCII strings are their own UTF-8 encoding.
+      if (PyUnicode_IS_ASCII(value)) {
+          attr.assign((const char *) PyUnicode_DATA(value),
+                (size_t) PyUnicode_GET_LENGTH(value));
+          return true;
+      }
+
+      // Use the string's UTF-8 representation if Python has cached it.
+      PyCompactUnicodeObject * cu = (PyCompactUnicodeObject *) value;
+      if (cu->utf8 != NULL) {
+          attr.assign(cu->utf8, (size_t) cu->utf8_length);
+          return true;
+      }
+
+      const void * data = PyUnicode_DATA(value);
+      const Py_ssize_t len = PyUnicode_GET_LENGTH(value);
+      if (len > directMax)
+          return false;
+      switch (PyUnicode_KIND(value)) {
+      case PyUnicode_1BYTE_KIND:
+          return _pySplRStringFromCodeUnits(attr, (const Py_UCS1 *) data, len);
+      case PyUnicode_2BYTE_KIND:
+          return _pySplRStringFromCodeUnits(attr, (const Py_UCS2 *) data, len);
+      case PyUnicode_4BYTE_KIND:
+          return _pySplRStringFromCodeUnits(attr, (const Py_UCS4 *) data, len);
+      }
+      return false;
+#else
+      const Py_ssize_t len = PyUnicode_GET_SIZE(value);
+      if (len > directMax)
+          return false;
+      return _pySplRStringFromCodeUnits(attr, PyUnicode_AS_UNICODE(value), len);
+#endif
+    }
+
     /*
     ** Convert to a SPL rstring from a Python string object.
     ** Returns 0 if successful, non-zero if error.
@@ -69,6 +188,12 @@ namespace streamsx {
       if (!PyUnicode_Check(value)) {
           // Create a string from the object
           value = converted = PyObject_Str(value);
+          if (value == NULL)
+              return -1;
+      }
+      if (_pySplRStringFromUnicode(attr, value)) {
+          Py_XDECREF(converted);
+          return 0;
       }
       bytes = PyUnicode_AsUTF8AndSize(value, &size);
 #else
@@ -77,6 +202,8 @@ namespace streamsx {
       // PyString_AsStringAndSize returns a pointer to an
       // internal buffer that must not be modified or deallocated
       if (PyUnicode_Check(value)) {
+          if (_pySplRStringFromUnicode(attr, value))
+              return 0;
           value = converted = PyUnicode_AsUTF8String(value);
       } else if (PyString_Check(value)) {
            // no coversion needed
@@ -107,16 +234,573 @@ namespace streamsx {
       return 0;
     }
 
+/**
+ * Python sub-interpreter an operator's Python code
+ * executes in, created by SplpySetup::newInterpreter.
+ *
+ * An operator binds its interpreter to the calling thread
+ * with a Scope at each entry point, SplpyGIL then acquires
+ * the GIL using the thread's state for that interpreter.
+ * Threads with no bound interpreter execute in the main
+ * interpreter through the PyGILState API.
+ *
+ * Sub-interpreters isolate each operator's modules and
+ * global state. With the supported Python versions all
+ * interpreters share the single GIL.
+ */
+class SplpyInterpreter {
+   public:
+        /**
+         * Binds an interpreter to the calling thread until
+         * the scope ends, NULL binds the main interpreter.
+         */
+        class Scope {
+           public:
+                Scope(SplpyInterpreter * interp) : prev_(bound()) {
+                    bound() = interp;
+                }
+                ~Scope() {
+                    bound() = prev_;
+                }
+           private:
+                SplpyInterpreter * prev_;
+        };
+
+        /**
+         * Interpreter bound to the calling thread,
+         * NULL for the main interpreter.
+         */
+        static SplpyInterpreter * current() {
+            return bound();
+        }
+
+        /**
+         * Wrap the thread state returned by Py_NewInterpreter
+         * which is the current thread state of the calling thread.
+         */
+        SplpyInterpreter(PyThreadState * ts) : ts_(ts) {
+            pthread_key_create(&key_, NULL);
+            Thread * thread = new Thread(ts);
+            thread->depth = 1;
+            threads_.push_back(thread);
+            pthread_setspecific(key_, thread);
+        }
+
+        /**
+         * End the interpreter, the calling thread
+         * must not hold the GIL.
+         */
+        ~SplpyInterpreter() {
+            PyGILState_STATE gstate = PyGILState_Ensure();
+            PyThreadState * main = PyThreadState_Swap(ts_);
+            for (std::map<const void *, PyObject *>::iterator it = objects_.begin();
+                 it != objects_.end(); ++it) {
+                Py_XDECREF(it->second);
+            }
+            for (size_t i = 0; i < threads_.size(); i++) {
+                if (threads_[i]->ts != ts_) {
+                    PyThreadState_Clear(threads_[i]->ts);
+                    PyThreadState_Delete(threads_[i]->ts);
+                }
+                delete threads_[i];
+            }
+            Py_EndInterpreter(ts_);
+            PyThreadState_Swap(main);
+            PyGILState_Release(gstate);
+            pthread_key_delete(key_);
+        }
+
+        /**
+         * Acquire the GIL with the calling thread's
+         * state for this interpreter.
+         */
+        void acquire() {
+            Thread * thread = this->thread();
+            if (thread->depth++ == 0)
+                PyEval_RestoreThread(thread->ts);
+        }
+        void release() {
+            Thread * thread = (Thread *) pthread_getspecific(key_);
+            if (--thread->depth == 0)
+                (void) PyEval_SaveThread();
+        }
+
+        /**
+         * Slot in this interpreter for the object held in
+         * main by the main interpreter.
+         * Caller must hold the GIL.
+         */
+        PyObject *& object(PyObject * const & main) {
+            return objects_[&main];
+        }
+
+   private:
+        struct Thread {
+            Thread(PyThreadState * ts) : ts(ts), depth(0) {}
+            PyThreadState * ts;
+            int depth;
+        };
+
+        static SplpyInterpreter *& bound() {
+            static __thread SplpyInterpreter * interp = NULL;
+            return interp;
+        }
+
+        // Calling thread's state for this interpreter,
+        // created on the thread's first use.
+        Thread * thread() {
+            Thread * thread = (Thread *) pthread_getspecific(key_);
+            if (thread != NULL)
+                return thread;
+
+            // Creating a thread state sets the thread's PyGILState
+            // state if it has none, ensure it is the main interpreter's.
+            PyGILState_STATE gstate = PyGILState_Ensure();
+            thread = new Thread(PyThreadState_New(ts_->interp));
+            threads_.push_back(thread);
+            PyGILState_Release(gstate);
+
+            pthread_setspecific(key_, thread);
+            return thread;
+        }
+
+        PyThreadState * ts_;
+        pthread_key_t key_;
+        std::vector<Thread *> threads_;
+        std::map<const void *, PyObject *> objects_;
+};
+
+/**
+ * Optional instrumentation of the time an operator's threads
+ * wait to acquire the GIL and then hold it, enabled by setting
+ * the environment variable STREAMSX_PYTHON_GIL_METRICS to 1.
+ *
+ * An operator binds its metrics to the calling thread with
+ * a Scope at each entry point, SplpyGIL then times one in
+ * SAMPLE outermost acquisitions on each thread and records
+ * the times in log2 histograms. Every PUBLISH samples the
+ * operator's custom metrics are updated:
+ *   nGILWaitNanos, nGILHoldNanos - estimated total times.
+ *   gilWaitP99Nanos, gilHoldP99Nanos - upper bound of the
+ *      histogram bucket containing the 99th percentile.
+ *
+ * clock_gettime(CLOCK_MONOTONIC) is used for timing as it
+ * is read without a system call on all supported platforms.
+ */
+class SplpyGILMetrics {
+   public:
+        enum { SAMPLE = 16, PUBLISH = 64, BUCKETS = 63 };
+
+        /**
+         * Binds metrics to the calling thread until the
+         * scope ends, NULL disables recording.
+         */
+        class Scope {
+           public:
+                Scope(SplpyGILMetrics * metrics) : prev_(thread().metrics) {
+                    thread().metrics = metrics;
+                }
+                ~Scope() {
+                    thread().metrics = prev_;
+                }
+           private:
+                SplpyGILMetrics * prev_;
+        };
+
+        /**
+         * Scope within which the calling thread has released
+         * the GIL it acquired, such as while submitting tuples,
+         * so that acquisitions by downstream operators are
+         * recorded as their own and not as the hold time.
+         */
+        class Released {
+           public:
+                Released() : metrics_(thread().metrics),
+                    depth_(thread().depth), held_(thread().held) {
+                    if (metrics_ != NULL && held_ != 0)
+                        metrics_->released();
+                    thread().depth = 0;
+                    thread().held = 0;
+                }
+                ~Released() {
+                    thread().depth = depth_;
+                    thread().held = held_ == 0 ? 0 : now();
+                }
+           private:
+                SplpyGILMetrics * metrics_;
+                int depth_;
+                uint64_t held_;
+        };
+
+        static SplpyGILMetrics * current() {
+            return thread().metrics;
+        }
+
+        static bool enabled() {
+            const char * value = getenv("STREAMSX_PYTHON_GIL_METRICS");
+            return value != NULL && strcmp(value, "1") == 0;
+        }
+
+        SplpyGILMetrics(SPL::Operator * op) :
+            waitTotal_(0), holdTotal_(0), samples_(0)
+        {
+            memset((void *) waitBuckets_, 0, sizeof(waitBuckets_));
+            memset((void *) holdBuckets_, 0, sizeof(holdBuckets_));
+
+            SPL::OperatorMetrics & metrics = op->getContext().getMetrics();
+            nWait_ = &metrics.createCustomMetric("nGILWaitNanos",
+                "Estimated total time in nanoseconds waiting to acquire the GIL.",
+                SPL::Metric::Counter);
+            nHold_ = &metrics.createCustomMetric("nGILHoldNanos",
+                "Estimated total time in nanoseconds holding the GIL.",
+                SPL::Metric::Counter);
+            waitP99_ = &metrics.createCustomMetric("gilWaitP99Nanos",
+                "99th percentile of the time in nanoseconds waiting to acquire the GIL.",
+                SPL::Metric::Gauge);
+            holdP99_ = &metrics.createCustomMetric("gilHoldP99Nanos",
+                "99th percentile of the time in nanoseconds holding the GIL.",
+                SPL::Metric::Gauge);
+        }
+
+        /**
+         * Called before acquiring the GIL, returns the
+         * start time if this acquisition is sampled, otherwise 0.
+         */
+        uint64_t acquiring() {
+            Thread & thread = SplpyGILMetrics::thread();
+            if (thread.depth++ != 0 || (++thread.count % SAMPLE) != 0)
+                return 0;
+            return now();
+        }
+
+        /**
+         * Called once the GIL is acquired.
+         */
+        void acquired(uint64_t start) {
+            if (start == 0)
+                return;
+            const uint64_t held = now();
+            record(waitBuckets_, waitTotal_, held - start);
+            thread().held = held;
+        }
+
+        /**
+         * Called before releasing the GIL.
+         */
+        void releasing() {
+            Thread & thread = SplpyGILMetrics::thread();
+            if (--thread.depth == 0 && thread.held != 0) {
+                released();
+                thread.held = 0;
+            }
+        }
+
+        /**
+         * Update the SPL metrics from the samples.
+         */
+        void publish() {
+            nWait_->setValue(waitTotal_ * SAMPLE);
+            nHold_->setValue(holdTotal_ * SAMPLE);
+            waitP99_->setValue(p99(waitBuckets_));
+            holdP99_->setValue(p99(holdBuckets_));
+        }
+
+   private:
+        struct Thread {
+            SplpyGILMetrics * metrics;
+            int depth;
+            uint32_t count;
+            // Start of a sampled hold, 0 when not sampled.
+            uint64_t held;
+        };
+
+        static Thread & thread() {
+            static __thread Thread thread = {NULL, 0, 0, 0};
+            return thread;
+        }
+
+        static uint64_t now() {
+            struct timespec ts;
+            clock_gettime(CLOCK_MONOTONIC, &ts);
+            return ((uint64_t) ts.tv_sec) * 1000000000ull + ts.tv_nsec;
+        }
+
+        void released() {
+            record(holdBuckets_, holdTotal_, now() - thread().held);
+            if (__sync_add_and_fetch(&samples_, 1) % PUBLISH == 0)
+                publish();
+        }
+
+        static void record(volatile uint32_t * buckets,
+                volatile uint64_t & total, uint64_t nanos) {
+            __sync_fetch_and_add(&total, nanos);
+            __sync_fetch_and_add(buckets + bucket(nanos), 1);
+        }
+
+        /**
+         * Bucket i holds times less than 2^i nanoseconds
+         * and, for i > 0, at least 2^(i-1).
+         */
+        static int bucket(uint64_t nanos) {
+            if (nanos == 0)
+                return 0;
+            const int i = 64 - __builtin_clzll(nanos);
+            return i < BUCKETS ? i : BUCKETS - 1;
+        }
+
+        static int64_t p99(volatile uint32_t * buckets) {
+            uint64_t count = 0;
+            for (int i = 0; i < BUCKETS; i++)
+                count += buckets[i];
+            if (count == 0)
+                return 0;
+            const uint64_t at = count - count / 100;
+            uint64_t cumulative = 0;
+            for (int i = 0; i < BUCKETS; i++) {
+                cumulative += buckets[i];
+                if (cumulative >= at)
+                    return (int64_t) (1ull << i);
+            }
+            return 0;
+        }
+
+        volatile uint32_t waitBuckets_[BUCKETS];
+        volatile uint32_t holdBuckets_[BUCKETS];
+        volatile uint64_t waitTotal_;
+        volatile uint64_t holdTotal_;
+        volatile uint32_t samples_;
+
+        SPL::Metric * nWait_;
+        SPL::Metric * nHold_;
+        SPL::Metric * waitP99_;
+        SPL::Metric * holdP99_;
+};
+
+/**
+ * Breakdown of the time an operator takes to process a tuple
+ * into stages, measured for one in every N input tuples, where
+ * N is 128 unless set by the environment variable
+ * STREAMSX_PYTHON_STAGE_SAMPLE, 0 disabling the measurement.
+ *
+ * The operator creates a Sample at the start of processing
+ * a tuple, and the time until each subsequent mark is added
+ * to the stage passed to the mark:
+ *   TO_PYTHON - conversion of the SPL tuple to Python arguments.
+ *   CALL - the Python callable, marked by pyCallTupleFunc for
+ *          the functional operators and around the call of the
+ *          callable by the SPL Python operators (or, for a FlatMap,
+ *          iterating over the callable's return).
+ *   FROM_PYTHON - conversion of the return to SPL tuples and
+ *          any remaining processing.
+ *   SUBMIT - submission of the output tuples within a Submit
+ *          scope, including any fused downstream operators.
+ *
+ * Every PUBLISH samples the averages of each stage over those
+ * samples are set as the operator's custom metrics
+ * toPythonNanos, callNanos, fromPythonNanos and submitNanos,
+ * and traced at debug level. The breakdown over all samples
+ * is traced at info level when the operator ends.
+ */
+class SplpyStageMetrics {
+   public:
+        enum Stage { TO_PYTHON, CALL, FROM_PYTHON, SUBMIT, STAGES };
+        enum { DEFAULT_SAMPLE = 128, PUBLISH = 64 };
+
+        /**
+         * Processing of a single input tuple, measured
+         * if the tuple is sampled. A sampled tuple's
+         * Sample is the calling thread's current sample.
+         */
+        class Sample {
+           public:
+                Sample(SplpyStageMetrics * metrics) :
+                    metrics_(metrics), prev_(current()), last_(0)
+                {
+                    if (metrics_ != NULL && metrics_->sampled()) {
+                        memset(nanos_, 0, sizeof(nanos_));
+                        last_ = now();
+                        current() = this;
+                    } else {
+                        current() = NULL;
+                    }
+                }
+                ~Sample() {
+                    if (last_ != 0) {
+                        mark(FROM_PYTHON);
+                        metrics_->record(nanos_);
+                    }
+                    current() = prev_;
+                }
+                void mark(Stage stage) {
+                    const uint64_t t = now();
+                    nanos_[stage] += t - last_;
+                    last_ = t;
+                }
+           private:
+                SplpyStageMetrics * metrics_;
+                Sample * prev_;
+                uint64_t last_;
+                uint64_t nanos_[STAGES];
+        };
+
+        /**
+         * Submission of output tuples, downstream operators
+         * called by the submit do not mark this operator's sample.
+         */
+        class Submit {
+           public:
+                Submit() : sample_(current()) {
+                    if (sample_ != NULL) {
+                        sample_->mark(FROM_PYTHON);
+                        current() = NULL;
+                    }
+                }
+                ~Submit() {
+                    if (sample_ != NULL) {
+                        current() = sample_;
+                        sample_->mark(SUBMIT);
+                    }
+                }
+           private:
+                Sample * sample_;
+        };
+
+        /**
+         * Mark the end of stage for the calling thread's
+         * current sample, if any.
+         */
+        static void mark(Stage stage) {
+            Sample * sample = current();
+            if (sample != NULL)
+                sample->mark(stage);
+        }
+
+        /**
+         * Sampling period from the environment.
+         */
+        static uint32_t period() {
+            const char * value = getenv("STREAMSX_PYTHON_STAGE_SAMPLE");
+            if (value == NULL)
+                return DEFAULT_SAMPLE;
+            const long n = strtol(value, NULL, 10);
+            return n > 0 ? (uint32_t) n : 0;
+        }
+
+        SplpyStageMetrics(SPL::Operator * op, uint32_t period) :
+            period_(period), count_(0), samples_(0)
+        {
+            memset(window_, 0, sizeof(window_));
+            memset(total_, 0, sizeof(total_));
+            pthread_mutex_init(&mutex_, NULL);
+
+            SPL::OperatorMetrics & metrics = op->getContext().getMetrics();
+            metrics_[TO_PYTHON] = &metrics.createCustomMetric("toPythonNanos",
+                "Average time in nanoseconds converting a sampled tuple to Python.",
+                SPL::Metric::Gauge);
+            metrics_[CALL] = &metrics.createCustomMetric("callNanos",
+                "Average time in nanoseconds in the Python callable for a sampled tuple.",
+                SPL::Metric::Gauge);
+            metrics_[FROM_PYTHON] = &metrics.createCustomMetric("fromPythonNanos",
+                "Average time in nanoseconds converting the callable's return for a sampled tuple to SPL.",
+                SPL::Metric::Gauge);
+            metrics_[SUBMIT] = &metrics.createCustomMetric("submitNanos",
+                "Average time in nanoseconds submitting the output tuples for a sampled tuple.",
+                SPL::Metric::Gauge);
+        }
+
+        ~SplpyStageMetrics() {
+            if (samples_ != 0) {
+                SPLAPPTRC(L_INFO, "Processing time " <<
+                    breakdown(total_, samples_), "python");
+            }
+            pthread_mutex_destroy(&mutex_);
+        }
+
+   private:
+        static Sample *& current() {
+            static __thread Sample * sample = NULL;
+            return sample;
+        }
+
+        static uint64_t now() {
+            struct timespec ts;
+            clock_gettime(CLOCK_MONOTONIC, &ts);
+            return ((uint64_t) ts.tv_sec) * 1000000000ull + ts.tv_nsec;
+        }
+
+        bool sampled() {
+            return __sync_add_and_fetch(&count_, 1) % period_ == 0;
+        }
+
+        void record(const uint64_t * nanos) {
+            pthread_mutex_lock(&mutex_);
+            for (int s = 0; s < STAGES; s++) {
+                window_[s] += nanos[s];
+                total_[s] += nanos[s];
+            }
+            if (++samples_ % PUBLISH == 0) {
+                for (int s = 0; s < STAGES; s++) {
+                    metrics_[s]->setValue((int64_t) (window_[s] / PUBLISH));
+                }
+                SPLAPPTRC(L_DEBUG, "Processing time " <<
+                    breakdown(window_, PUBLISH), "python");
+                memset(window_, 0, sizeof(window_));
+            }
+            pthread_mutex_unlock(&mutex_);
+        }
+
+        /**
+         * Average time of each stage over samples
+         * and its percentage of the total.
+         */
+        static std::string breakdown(const uint64_t * nanos, uint64_t samples) {
+            static const char * names[] =
+                {"toPython", "call", "fromPython", "submit"};
+            uint64_t all = 0;
+            for (int s = 0; s < STAGES; s++)
+                all += nanos[s];
+            std::ostringstream out;
+            out << "over " << samples << " sampled tuples:";
+            for (int s = 0; s < STAGES; s++) {
+                out << " " << names[s] << "=" << (nanos[s] / samples) << "ns("
+                    << (all == 0 ? 0 : (100 * nanos[s]) / all) << "%)";
+            }
+            return out.str();
+        }
+
+        const uint32_t period_;
+        volatile uint32_t count_;
+        uint64_t samples_;
+        uint64_t window_[STAGES];
+        uint64_t total_[STAGES];
+        pthread_mutex_t mutex_;
+        SPL::Metric * metrics_[STAGES];
+};
+
 class SplpyGIL {
    public:
-        SplpyGIL() {
-          gstate_ = PyGILState_Ensure();
+        SplpyGIL() : interp_(SplpyInterpreter::current()),
+            metrics_(SplpyGILMetrics::current()) {
+          const uint64_t start = metrics_ == NULL ? 0 : metrics_->acquiring();
+          if (interp_ == NULL)
+              gstate_ = PyGILState_Ensure();
+          else
+              interp_->acquire();
+          if (start != 0)
+              metrics_->acquired(start);
         }
         ~SplpyGIL() {
-          PyGILState_Release(gstate_);
+          if (metrics_ != NULL)
+              metrics_->releasing();
+          if (interp_ == NULL)
+              PyGILState_Release(gstate_);
+          else
+              interp_->release();
         }
         
       private:
+        SplpyInterpreter * interp_;
+        SplpyGILMetrics * metrics_;
         PyGILState_STATE gstate_;
     };
 
@@ -239,11 +923,11 @@ class SplpyGeneral {
      */
     static PyObject * timestampClass(PyObject *tsc) {
         static PyObject * tsClass = tsc;
-        return tsClass;
+        return perInterpreter(tsClass, tsc);
     }
     static PyObject * decimalClass(PyObject *dsc) {
         static PyObject * decClass = dsc;
-        return decClass;
+        return perInterpreter(decClass, dsc);
     }
     /**
      * streamsx.spl.types._get_timestamp_tuple
@@ -251,7 +935,42 @@ class SplpyGeneral {
      */
     static PyObject * timestampGetter(PyObject *tsg) {
         static PyObject * tsGetter = tsg;
-        return tsGetter;
+        return perInterpreter(tsGetter, tsg);
+    }
+
+    /**
+     * Value of a static variable holding a Python object
+     * for the current interpreter. main is the value for
+     * the main interpreter, a sub-interpreter has its own
+     * value which is set by a non-NULL value.
+     *
+     * None (isNone, getNone) and memoryview's type
+     * (checkMemoryView) are shared by all interpreters.
+     */
+    static PyObject * perInterpreter(PyObject * const & main, PyObject * value) {
+        SplpyInterpreter * interp = SplpyInterpreter::current();
+        if (interp == NULL)
+            return main;
+        PyObject *& sub = interp->object(main);
+        if (value != NULL)
+            sub = value;
+        return sub;
+    }
+
+    /**
+     * Callable in a module for the current interpreter,
+     * loaded on first use. cache holds the callable for
+     * the main interpreter and must be initialized to NULL.
+     * Returns a borrowed reference.
+     *
+     * Caller must hold the GILState
+     */
+    static PyObject * cachedFunction(PyObject * & cache, const char * mn, const char * fn) {
+        SplpyInterpreter * interp = SplpyInterpreter::current();
+        PyObject *& function = interp == NULL ? cache : interp->object(cache);
+        if (function == NULL)
+            function = loadFunction(mn, fn);
+        return function;
     }
 
 
@@ -696,8 +1415,22 @@ class SplpyExceptionInfo {
      *    Python object to tuple containing:
      *      (seconds, nanoseconds, machine_id)
      * 2) Extract values from each tuple element.
+     *
+     * A streamsx.spl.types.Timestamp is a tuple of
+     * (seconds, nanoseconds, machine_id) so its values
+     * are extracted directly.
      */
     inline void pySplValueFromPyObject(SPL::timestamp & splv, PyObject *value) {
+        if (Py_TYPE(value) == (PyTypeObject *) SplpyGeneral::timestampClass(NULL)) {
+            splv.setSeconds(
+                (int64_t) PyLong_AsLong(PyTuple_GET_ITEM(value, 0)));
+            splv.setNanoSeconds(
+                (uint32_t) PyLong_AsUnsignedLong(PyTuple_GET_ITEM(value, 1)));
+            splv.setMachineId(
+                (int32_t) PyLong_AsLong(PyTuple_GET_ITEM(value, 2)));
+            return;
+        }
+
         PyObject * args = PyTuple_New(1);
         Py_INCREF(value);
         PyTuple_SET_ITEM(args, 0, value);
@@ -766,9 +1499,97 @@ class SplpyExceptionInfo {
         );
     }
 
-    // SPL list from Python list
+    /*
+     * Buffer protocol item kind and format for SPL numeric types
+     * whose list values are contiguous arrays, zero for all other
+     * types. The kind is 'i' for signed integers, 'u' for unsigned
+     * integers and 'f' for floating point.
+     */
+    template <typename T>
+    struct SplpyBufferType {
+        static const char kind = 0;
+        static const char format = 0;
+    };
+
+#define SPLPY_BUFFER_TYPE(T, K, F) \
+    template <> \
+    struct SplpyBufferType<T> { \
+        static const char kind = K; \
+        static const char format = F; \
+    }
+
+    SPLPY_BUFFER_TYPE(SPL::int8, 'i', 'b');
+    SPLPY_BUFFER_TYPE(SPL::int16, 'i', 'h');
+    SPLPY_BUFFER_TYPE(SPL::int32, 'i', 'i');
+    SPLPY_BUFFER_TYPE(SPL::int64, 'i', 'q');
+    SPLPY_BUFFER_TYPE(SPL::uint8, 'u', 'B');
+    SPLPY_BUFFER_TYPE(SPL::uint16, 'u', 'H');
+    SPLPY_BUFFER_TYPE(SPL::uint32, 'u', 'I');
+    SPLPY_BUFFER_TYPE(SPL::uint64, 'u', 'Q');
+    SPLPY_BUFFER_TYPE(SPL::float32, 'f', 'f');
+    SPLPY_BUFFER_TYPE(SPL::float64, 'f', 'd');
+
+#undef SPLPY_BUFFER_TYPE
+
+    /*
+     * Return the item kind of a native single item
+     * buffer format, or zero if it is not a numeric format.
+     * A NULL format is unsigned bytes.
+     */
+    inline char pySplBufferKind(const char * format) {
+        if (format == NULL)
+            return 'u';
+        if (*format == '@')
+            format++;
+        if (format[0] == 0 || format[1] != 0)
+            return 0;
+        switch (format[0]) {
+        case 'b': case 'h': case 'i': case 'l': case 'q': case 'n':
+            return 'i';
+        case 'B': case 'H': case 'I': case 'L': case 'Q': case 'N':
+            return 'u';
+        case 'f': case 'd':
+            return 'f';
+        }
+        return 0;
+    }
+
+    /*
+     * Append the contents of a buffer to a numeric SPL list
+     * with a single copy. The buffer must be C contiguous with
+     * items of the same kind and size as the list's elements,
+     * multi-dimensional buffers are flattened.
+     */
+    template <typename T>
+    inline void pySplValueFromPyBuffer(SPL::list<T> & l, PyObject *value) {
+        Py_buffer buf;
+        if (PyObject_GetBuffer(value, &buf, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0)
+            throw SplpyExceptionInfo::dataConversion("list (buffer)");
+
+        if (buf.itemsize != sizeof(T) || pySplBufferKind(buf.format) != SplpyBufferType<T>::kind) {
+            PyBuffer_Release(&buf);
+            throw SplpyExceptionInfo::dataConversion("list (buffer format)");
+        }
+
+        const size_t n = buf.len / sizeof(T);
+        if (n != 0) {
+            const size_t offset = l.size();
+            l.resize(offset + n);
+            memcpy((void *) &l[offset], buf.buf, n * sizeof(T));
+        }
+        PyBuffer_Release(&buf);
+    }
+
+    // SPL list from Python list, or for
+    // numeric lists any object supporting the buffer protocol
     template <typename T>
     inline void pySplValueFromPyObject(SPL::list<T> & l, PyObject *value) {
+        if (SplpyBufferType<T>::kind != 0 && !PyList_Check(value)
+             && PyObject_CheckBuffer(value)) {
+            pySplValueFromPyBuffer(l, value);
+            return;
+        }
+
         const Py_ssize_t size = PyList_Size(value);
 
         for (Py_ssize_t i = 0; i < size; i++) {
@@ -875,6 +1696,55 @@ class SplpyExceptionInfo {
     }
 
 
+    /**
+     * Return true if the data contains only ASCII characters.
+     * Scans 16 bytes at a time using SSE2 when available,
+     * otherwise a word at a time.
+     */
+    inline bool pySplIsAscii(const char * data, size_t size) {
+      const unsigned char * p = (const unsigned char *) data;
+      const unsigned char * end = p + size;
+
+#if defined(__SSE2__)
+      // movemask collects the high bit of each byte.
+      for (; p + sizeof(__m128i) <= end; p += sizeof(__m128i)) {
+          __m128i chunk = _mm_loadu_si128((const __m128i *) p);
+          if (_mm_movemask_epi8(chunk))
+              return false;
+      }
+#endif
+
+      const uint64_t highBits = 0x8080808080808080ULL;
+      for (; p + sizeof(uint64_t) <= end; p += sizeof(uint64_t)) {
+          uint64_t word;
+          memcpy(&word, p, sizeof(word));
+          if (word & highBits)
+              return false;
+      }
+      for (; p < end; p++) {
+          if (*p & 0x80)
+              return false;
+      }
+      return true;
+    }
+
+    /**
+     * Convert UTF-8 data into a Python Unicode string.
+     * With Python 3 ASCII only data (ascii is true) is copied
+     * directly into a compact ASCII string, avoiding decoding.
+     */
+    inline PyObject * pySplUnicodeFromUTF8(const char * data, size_t size, bool ascii) {
+#if PY_MAJOR_VERSION == 3
+      if (ascii) {
+          PyObject * str = PyUnicode_New(size, 127);
+          if (str != NULL)
+              memcpy(PyUnicode_1BYTE_DATA(str), data, size);
+          return str;
+      }
+#endif
+      return PyUnicode_DecodeUTF8(data, size, NULL);
+    }
+
     /**
      * Convert a SPL rstring into a Python Unicode string 
      */
@@ -882,7 +1752,11 @@ class SplpyExceptionInfo {
       long int sizeb = value.size();
       const char * pybytes = value.data();
 
+#if PY_MAJOR_VERSION == 3
+      return pySplUnicodeFromUTF8(pybytes, sizeb, pySplIsAscii(pybytes, sizeb));
+#else
       return PyUnicode_DecodeUTF8(pybytes, sizeb, NULL);
+#endif
     }
     /**
      * Convert a SPL ustring into a Python Unicode string 
@@ -904,12 +1778,12 @@ class SplpyExceptionInfo {
     /**
      *  Convert decimal values by first converting to strings
      *  and then creating Python decimal.Decimal instance.
+     *  The formatted value is always ASCII.
      */
-    inline PyObject * _pySplDecStringToPyDecimal(const std::stringstream & buf)
+    inline PyObject * _pySplDecStringToPyDecimal(const std::string & decString)
     {
-        SPL::rstring decString(buf.str());
-
-        PyObject * pyDecString = pySplValueToPyObject(decString);
+        PyObject * pyDecString = pySplUnicodeFromUTF8(
+              decString.data(), decString.size(), true);
 
         PyObject * pyTuple = PyTuple_New(1);
         PyTuple_SET_ITEM(pyTuple, 0, pyDecString);
@@ -919,42 +1793,74 @@ class SplpyExceptionInfo {
                  pyTuple
                );
     }
-    inline PyObject * pySplValueToPyObject(const SPL::decimal32 & value) {
+    inline void _pySplDeleteDecStream(void * buf) {
+        delete static_cast<std::ostringstream *>(buf);
+    }
 
-        // Number of decimal32 digits (7) minus 1 to account
+    /**
+     * Stream used to format decimal values by the calling thread,
+     * deleted when the thread exits.
+     * A stream is kept per thread as constructing a stream
+     * for each value costs more than formatting the value.
+     */
+    inline std::ostringstream * _pySplDecStream() {
+        static pthread_key_t key;
+        static const int rc = pthread_key_create(&key, _pySplDeleteDecStream);
+        if (rc != 0)
+            return NULL;
+
+        std::ostringstream * buf = static_cast<std::ostringstream *>(pthread_getspecific(key));
+        if (buf == NULL) {
+            buf = new std::ostringstream();
+            buf->setf(std::ios::scientific, std::ios::floatfield);
+            pthread_setspecific(key, buf);
+        }
+        return buf;
+    }
+
+    /**
+     * Format a decimal value with digits significant digits.
+     * Does not require the GIL.
+     */
+    template <typename D>
+    inline std::string _pySplDecString(const D & value, int digits) {
+        std::ostringstream * buf = _pySplDecStream();
+        if (buf == NULL) {
+            std::ostringstream sbuf;
+            sbuf.setf(std::ios::scientific, std::ios::floatfield);
+            sbuf.precision(digits - 1);
+            sbuf << value;
+            return sbuf.str();
+        }
+        buf->str(std::string());
+        buf->clear();
+
+        // Number of digits minus 1 to account
         // for the single digit written before the decimal point
         // in scientific notation
         // www.cplusplus.com/reference/ios/scientific
-        std::stringstream buf;
-        buf.setf(std::ios::scientific, std::ios::floatfield);
-        buf.precision(7 - 1);
-        buf << value;
+        buf->precision(digits - 1);
+        *buf << value;
+        return buf->str();
+    }
+    inline std::string pySplDecString(const SPL::decimal32 & value) {
+        return _pySplDecString(value, 7);
+    }
+    inline std::string pySplDecString(const SPL::decimal64 & value) {
+        return _pySplDecString(value, 16);
+    }
+    inline std::string pySplDecString(const SPL::decimal128 & value) {
+        return _pySplDecString(value, 34);
+    }
 
-        return _pySplDecStringToPyDecimal(buf);
+    inline PyObject * pySplValueToPyObject(const SPL::decimal32 & value) {
+        return _pySplDecStringToPyDecimal(pySplDecString(value));
     }
     inline PyObject * pySplValueToPyObject(const SPL::decimal64 & value) {
-        // Number of decimal64 digits (16) minus 1 to account
-        // for the single digit written before the decimal point
-        // in scientific notation
-        // www.cplusplus.com/reference/ios/scientific
-        std::stringstream buf;
-        buf.setf(std::ios::scientific, std::ios::floatfield);
-        buf.precision(16 - 1);
-        buf << value;
-
-        return _pySplDecStringToPyDecimal(buf);
+        return _pySplDecStringToPyDecimal(pySplDecString(value));
     }
     inline PyObject * pySplValueToPyObject(const SPL::decimal128 & value) {
-        // Number of decimal128 digits (34) minus 1 to account
-        // for the single digit written before the decimal point
-        // in scientific notation
-        // www.cplusplus.com/reference/ios/scientific
-        std::stringstream buf;
-        buf.setf(std::ios::scientific, std::ios::floatfield);
-        buf.precision(34 - 1);
-        buf << value;
-
-        return _pySplDecStringToPyDecimal(buf);
+        return _pySplDecStringToPyDecimal(pySplDecString(value));
     }
 
     inline PyObject * pySplValueToPyObject(const SPL::boolean & value) {
@@ -968,8 +1874,29 @@ class SplpyExceptionInfo {
        return PyFloat_FromDouble(value);
     }
 
+    /**
+     * Convert an SPL timestamp to a streamsx.spl.types.Timestamp.
+     *
+     * With Python 3, as Timestamp is a tuple the instance is
+     * allocated and filled in directly, rather than calling the class.
+     * An invalid nanoseconds value is passed to the class
+     * so that it raises the same error as Python code.
+     */
     inline PyObject * pySplValueToPyObject(const SPL::timestamp & value) {
         int32_t mid = value.getMachineId();
+#if PY_MAJOR_VERSION == 3
+        if (value.getNanoseconds() < 1000000000) {
+            PyTypeObject * tsType = (PyTypeObject *) SplpyGeneral::timestampClass(NULL);
+            PyObject * ts = tsType->tp_alloc(tsType, 3);
+            if (ts == NULL)
+                throw SplpyGeneral::pythonException("timestamp");
+            PyTuple_SET_ITEM(ts, 0, pySplValueToPyObject(value.getSeconds()));
+            PyTuple_SET_ITEM(ts, 1, pySplValueToPyObject(value.getNanoseconds()));
+            PyTuple_SET_ITEM(ts, 2, pySplValueToPyObject(mid));
+            return ts;
+        }
+#endif
+
         PyObject * pyTuple = PyTuple_New(mid == 0 ? 2 : 3);
 
         PyTuple_SET_ITEM(pyTuple, 0, pySplValueToPyObject(value.getSeconds()));
@@ -1005,12 +1932,70 @@ class SplpyExceptionInfo {
         return pyList;
     }
 
+    /*
+    ** SPL numeric list as a read-only memoryview
+    ** over the list's storage, with the item format
+    ** matching the element type. Like a blob's memoryview
+    ** it is only valid while the list is and must be
+    ** released using MemoryViewCleanup.
+    **
+    ** Python 2 has no release of a memoryview so
+    ** a Python list is returned.
+    */
+    template <typename T>
+    inline PyObject * pySplValueToPyBuffer(const SPL::list<T> & l) {
+#if PY_MAJOR_VERSION == 3
+        static char format[] = {SplpyBufferType<T>::format, 0};
+
+        // A memoryview requires a non-NULL pointer even when empty.
+        static T empty;
+
+        Py_buffer buf;
+        PyBuffer_FillInfo(&buf, NULL, l.empty() ? (void *) &empty : (void *) &l[0],
+             (Py_ssize_t) (l.size() * sizeof(T)), 1, PyBUF_SIMPLE);
+        buf.format = format;
+        buf.itemsize = sizeof(T);
+
+        // PyMemoryView_FromBuffer makes a copy of the info from buf,
+        // its shape is calculated from the length and item size.
+        return PyMemoryView_FromBuffer(&buf);
+#else
+        return pySplValueToPyObject(l);
+#endif
+    }
+
+    /*
+    ** Column of an attribute's values from the tuples in
+    ** a window. A numeric column is an array.array owning a
+    ** copy of the values, with the item format matching the
+    ** element type, so it supports the buffer protocol.
+    ** Other columns, or any with Python 2, are a Python list.
+    */
+    template <typename T>
+    inline PyObject * pySplColumnToPyObject(const SPL::list<T> & l) {
+#if PY_MAJOR_VERSION == 3
+        if (SplpyBufferType<T>::kind != 0) {
+            static PyObject * arrayClass = SplpyGeneral::loadFunction("array", "array");
+            static char format[] = {SplpyBufferType<T>::format, 0};
+
+            // array.array initialized from the bytes of the values.
+            PyObject * pyTuple = PyTuple_New(2);
+            PyTuple_SET_ITEM(pyTuple, 0, pyUnicode_FromUTF8(format));
+            PyTuple_SET_ITEM(pyTuple, 1, PyBytes_FromStringAndSize(
+                l.empty() ? NULL : (const char *) &l[0],
+                (Py_ssize_t) (l.size() * sizeof(T))));
+            return SplpyGeneral::pyCallObject(arrayClass, pyTuple);
+        }
+#endif
+        return pySplValueToPyObject(l);
+    }
+
     /*
     ** SPL Map Conversion to Python dict.
     */
     template <typename K, typename V>
     inline PyObject * pySplValueToPyObject(const SPL::map<K,V> & m) {
-        PyObject * pyDict = PyDict_New();
+        PyObject * pyDict = _PyDict_NewPresized(m.size());
         for (typename std::tr1::unordered_map<K,V>::const_iterator it = m.begin();
              it != m.end(); it++) {
              PyObject *k = pySplValueToPyObject(it->first);
@@ -1048,6 +2033,276 @@ class SplpyExceptionInfo {
     }
 #endif
 
+/**
+ * Staged conversion of an SPL value to a Python object.
+ *
+ * Converting an SPL tuple is split into a phase that
+ * does not hold the GIL, constructing an SplpyStaged
+ * for each attribute to perform any work that does not
+ * involve Python objects, followed by a phase holding the GIL
+ * that only creates the Python objects through toPyObject().
+ * This reduces the time the GIL is held, which matters when
+ * multiple Python operators are fused into a single PE.
+ *
+ * The value being staged must remain valid until
+ * toPyObject() is called, typically it is an attribute
+ * of the tuple being processed.
+ *
+ * By default there is no work to stage and the
+ * value is converted by pySplValueToPyObject().
+ */
+template <typename T>
+class SplpyStaged {
+   public:
+        SplpyStaged(const T & value) : value_(value) {
+        }
+        PyObject * toPyObject() const {
+            return pySplValueToPyObject(value_);
+        }
+   private:
+        const T & value_;
+};
+
+/**
+ * Staged numeric list passed to Python as a memoryview
+ * of the list's storage, see pySplValueToPyBuffer().
+ */
+template <typename L>
+class SplpyStagedBuffer {
+   public:
+        SplpyStagedBuffer(const L & value) : value_(value) {
+        }
+        PyObject * toPyObject() const {
+            return pySplValueToPyBuffer(value_);
+        }
+   private:
+        const L & value_;
+};
+
+/**
+ * Cache of Python strings for short rstring values,
+ * for attributes with a small number of distinct
+ * values such as codes or status values where creating
+ * a new Python string for every tuple is wasted work.
+ *
+ * The cache is direct mapped, a value replaces any
+ * existing entry in its slot. If after an initial
+ * period few lookups are hits then the attribute
+ * is assumed to have many distinct values and
+ * the cache disables itself.
+ *
+ * All methods apart from hash() must be called holding the GIL.
+ *
+ * Instances are never destroyed, they are static
+ * to an operator's generated code, so that the Python
+ * strings are not released after the interpreter
+ * has been finalized. A static instance is shared by
+ * every invocation of the operator in the PE, so it is
+ * only used by invocations executing in the main interpreter,
+ * see main().
+ */
+class SplpyStringCache {
+   public:
+        // Longest value (in bytes) that is cached.
+        static const size_t MAX_SIZE = 16;
+
+        SplpyStringCache() : lookups_(0), hits_(0), enabled_(true) {
+            memset(entries_, 0, sizeof(entries_));
+        }
+
+        bool enabled() const {
+            return enabled_;
+        }
+
+        /**
+         * Cache to use for the calling thread, NULL when it is
+         * executing in a sub-interpreter as the cached strings
+         * belong to the main interpreter and outlive any other.
+         */
+        static SplpyStringCache * main(SplpyStringCache & cache) {
+            return SplpyInterpreter::current() == NULL ? &cache : NULL;
+        }
+
+        /**
+         * Hash of a value for lookup, zero if the
+         * value is too long to be cached.
+         * Does not require the GIL.
+         */
+        static uint32_t hash(const char * data, size_t size) {
+            if (size > MAX_SIZE)
+                return 0;
+            // FNV-1a
+            uint32_t h = 2166136261U;
+            for (size_t i = 0; i < size; i++) {
+                h ^= (unsigned char) data[i];
+                h *= 16777619U;
+            }
+            return h | 1;
+        }
+
+        /**
+         * Return a new reference to the cached string for
+         * the value or NULL if it is not cached.
+         */
+        PyObject * get(const char * data, size_t size, uint32_t hash) {
+            Entry & e = entries_[hash % SLOTS];
+            const bool hit = e.value != NULL && e.hash == hash
+                && e.size == size && memcmp(e.data, data, size) == 0;
+
+            if (lookups_ < SAMPLE) {
+                lookups_++;
+                if (hit)
+                    hits_++;
+                else if (lookups_ == SAMPLE && hits_ * 4 < SAMPLE)
+                    enabled_ = false;
+            }
+
+            if (!hit)
+                return NULL;
+            Py_INCREF(e.value);
+            return e.value;
+        }
+
+        /**
+         * Cache value as the Python string for the value.
+         */
+        void put(const char * data, size_t size, uint32_t hash, PyObject * value) {
+            Entry & e = entries_[hash % SLOTS];
+            PyObject * old = e.value;
+            Py_INCREF(value);
+            e.value = value;
+            e.hash = hash;
+            e.size = (unsigned char) size;
+            memcpy(e.data, data, size);
+            Py_XDECREF(old);
+        }
+
+   private:
+        static const size_t SLOTS = 64;
+        static const uint32_t SAMPLE = 1024;
+
+        struct Entry {
+            PyObject * value;
+            uint32_t hash;
+            unsigned char size;
+            char data[MAX_SIZE];
+        };
+
+        Entry entries_[SLOTS];
+        uint32_t lookups_;
+        uint32_t hits_;
+        bool enabled_;
+};
+
+/**
+ * rstring values are scanned without the GIL so that
+ * ASCII only values (the common case) are created by
+ * copying the bytes, avoiding any UTF-8 decoding while
+ * holding the GIL. Other values are decoded (and validated)
+ * by Python's UTF-8 decoder.
+ *
+ * If cache is set then short values are looked up
+ * in the cache before creating a new Python string.
+ */
+template <>
+class SplpyStaged<SPL::rstring> {
+   public:
+        SplpyStaged(const SPL::rstring & value, SplpyStringCache * cache = NULL) :
+            data_(value.data()), size_(value.size()),
+            ascii_(pySplIsAscii(data_, size_)),
+            cache_(cache),
+            hash_(cache == NULL ? 0 : SplpyStringCache::hash(data_, size_))
+        {
+        }
+        PyObject * toPyObject() const {
+            if (hash_ == 0 || !cache_->enabled())
+                return pySplUnicodeFromUTF8(data_, size_, ascii_);
+
+            PyObject * str = cache_->get(data_, size_, hash_);
+            if (str == NULL) {
+                str = pySplUnicodeFromUTF8(data_, size_, ascii_);
+                if (str != NULL && cache_->enabled())
+                    cache_->put(data_, size_, hash_, str);
+            }
+            return str;
+        }
+        bool ascii() const {
+            return ascii_;
+        }
+   private:
+        const char * data_;
+        const size_t size_;
+        const bool ascii_;
+        SplpyStringCache * const cache_;
+        const uint32_t hash_;
+};
+
+/**
+ * Decimal values are formatted without the GIL, with
+ * just the decimal.Decimal instance created holding it.
+ */
+class SplpyStagedDecimal {
+   public:
+        SplpyStagedDecimal(const std::string & value) : value_(value) {
+        }
+        PyObject * toPyObject() const {
+            return _pySplDecStringToPyDecimal(value_);
+        }
+   private:
+        const std::string value_;
+};
+
+template <>
+class SplpyStaged<SPL::decimal32> : public SplpyStagedDecimal {
+   public:
+        SplpyStaged(const SPL::decimal32 & value) :
+            SplpyStagedDecimal(pySplDecString(value)) {
+        }
+};
+template <>
+class SplpyStaged<SPL::decimal64> : public SplpyStagedDecimal {
+   public:
+        SplpyStaged(const SPL::decimal64 & value) :
+            SplpyStagedDecimal(pySplDecString(value)) {
+        }
+};
+template <>
+class SplpyStaged<SPL::decimal128> : public SplpyStagedDecimal {
+   public:
+        SplpyStaged(const SPL::decimal128 & value) :
+            SplpyStagedDecimal(pySplDecString(value)) {
+        }
+};
+
+/**
+ * RAII access to the contents of a Python object
+ * that supports the buffer protocol, such as
+ * bytes, bytearray, array.array or a numpy array.
+ *
+ * Caller must hold the GIL for the lifetime of the object.
+ */
+class SplpyBuffer {
+   public:
+        SplpyBuffer(PyObject * obj, int flags = PyBUF_SIMPLE) {
+            if (PyObject_GetBuffer(obj, &view_, flags) != 0)
+                throw SplpyExceptionInfo::dataConversion("buffer");
+        }
+        ~SplpyBuffer() {
+            PyBuffer_Release(&view_);
+        }
+        const unsigned char * data() const {
+            return (const unsigned char *) view_.buf;
+        }
+        Py_ssize_t size() const {
+            return view_.len;
+        }
+        const Py_buffer & view() const {
+            return view_;
+        }
+   private:
+        Py_buffer view_;
+};
+
 /*
  * A MemoryView from a blob attribute in an SPL schema
  * just points to the tuple memory. In 3 this is safe
@@ -1123,9 +2378,10 @@ class MemoryViewCleanup {
       private:
         std::vector<PyObject *> mvs_;
 
+        // Caller must hold the GILState
         static PyObject * releaser() {
-           static PyObject * releaser = SplpyGeneral::loadFunctionGIL("streamsx.spl.runtime", "_splpy_release_memoryviews");
-           return releaser;
+           static PyObject * releaser = NULL;
+           return SplpyGeneral::cachedFunction(releaser, "streamsx.spl.runtime", "_splpy_release_memoryviews");
         }
 };
 
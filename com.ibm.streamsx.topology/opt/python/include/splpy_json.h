@@ -0,0 +1,853 @@
+/*
+# Licensed Materials - Property of IBM
+# Copyright IBM Corp. 2018
+*/
+
+/*
+ * Internal header file supporting Python
+ * for com.ibm.streamsx.topology.
+ *
+ * This is not part of any public api for
+ * the toolkit or toolkit with decorated
+ * SPL Python operators.
+ *
+ * Functionality related to converting JSON documents
+ * (CommonSchema.Json) between SPL rstring attributes
+ * and Python objects without calling the json module.
+ */
+
+#ifndef __SPL__SPLPY_JSON_H
+#define __SPL__SPLPY_JSON_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <locale.h>
+#include <math.h>
+#include <float.h>
+#include <string>
+#include <vector>
+
+#include "splpy_general.h"
+
+namespace streamsx {
+  namespace topology {
+
+/**
+ * Return the first character in the range that is a
+ * quote, backslash or control character, or end if there
+ * is none. ascii is cleared if any character before it
+ * is not ASCII.
+ * Scans 16 bytes at a time using SSE2 when available,
+ * otherwise a word at a time.
+ */
+inline const char * pySplJSONScan(const char * data, const char * end, bool & ascii) {
+    const unsigned char * p = (const unsigned char *) data;
+    const unsigned char * e = (const unsigned char *) end;
+    int high = 0;
+
+#if defined(__SSE2__)
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control = _mm_set1_epi8(0x1f);
+    for (; p + sizeof(__m128i) <= e; p += sizeof(__m128i)) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *) p);
+        __m128i special = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+            _mm_cmpeq_epi8(_mm_max_epu8(chunk, control), control));
+        int mask = _mm_movemask_epi8(special);
+        if (mask) {
+            // Only the characters before the first special one
+            high |= _mm_movemask_epi8(chunk) & ((mask & -mask) - 1);
+            if (high)
+                ascii = false;
+            return (const char *) p + __builtin_ctz(mask);
+        }
+        high |= _mm_movemask_epi8(chunk);
+    }
+#endif
+
+    // A byte is special if it is less than 0x20
+    // or is zero once xor'ed with a quote or backslash.
+    const uint64_t ones = 0x0101010101010101ULL;
+    const uint64_t highBits = 0x8080808080808080ULL;
+    for (; p + sizeof(uint64_t) <= e; p += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, p, sizeof(word));
+        const uint64_t q = word ^ (ones * '"');
+        const uint64_t b = word ^ (ones * '\\');
+        if ((((word - ones * 0x20) & ~word) | ((q - ones) & ~q) | ((b - ones) & ~b)) & highBits)
+            break;
+        high |= (word & highBits) != 0;
+    }
+    for (; p < e; p++) {
+        if (*p == '"' || *p == '\\' || *p < 0x20)
+            break;
+        high |= *p & 0x80;
+    }
+    if (high)
+        ascii = false;
+    return (const char *) p;
+}
+
+/**
+ * C locale for converting floating point values
+ * independently of the process's locale.
+ */
+inline locale_t pySplJSONLocale() {
+    static locale_t c = newlocale(LC_ALL_MASK, "C", (locale_t) 0);
+    return c;
+}
+
+#if PY_MAJOR_VERSION == 3
+/**
+ * Parser of a JSON document into a sequence of
+ * values (a tape) from which Python objects are built.
+ *
+ * Parsing does not call into Python so that it is done
+ * without holding the GIL, which is only held while the
+ * objects are built (see SplpyJSON).
+ *
+ * Only documents json.loads produces the same objects for
+ * are accepted, the parser rejects any other document,
+ * including invalid JSON, integers outside 64 bits and
+ * strings containing escaped lone surrogates.
+ * Such documents are loaded by json.loads so that the
+ * objects and errors are those of the json module.
+ */
+class SplpyJSONParser {
+  public:
+    // Deeper documents are loaded by json.loads
+    static const int MAX_DEPTH = 512;
+
+    SplpyJSONParser() : seq_(0), data_(NULL), p_(NULL), end_(NULL) {}
+
+    /**
+     * Parse a document, returning true if it is accepted.
+     * Strings without escapes refer to the document so it must
+     * not be modified until the objects have been built.
+     */
+    bool parse(const char * data, size_t size) {
+        seq_++;
+        tape_.clear();
+        text_.clear();
+        data_ = p_ = data;
+        end_ = data + size;
+        if (!value(0))
+            return false;
+        skip();
+        return p_ == end_;
+    }
+
+    /**
+     * Identifier of the last parsed document.
+     */
+    uint64_t seq() const {
+        return seq_;
+    }
+
+    /**
+     * Build the objects for the last parsed document, data
+     * is the document, returning a new reference or NULL
+     * with a Python error set.
+     * Caller must hold the GIL.
+     */
+    PyObject * build(const char * data) {
+        size_t i = 0;
+        return build(data, i);
+    }
+
+  private:
+    enum Type { NUL, FALSE, TRUE, INT, FLOAT, STRING, ARRAY, OBJECT };
+
+    struct Value {
+        unsigned char type;
+        // STRING: only ASCII characters
+        bool ascii;
+        // STRING: unescaped into text_ rather than in the document
+        bool escaped;
+        // STRING: length in bytes, ARRAY: items, OBJECT: members
+        size_t size;
+        union {
+            int64_t i;
+            double d;
+            size_t offset;
+        } v;
+    };
+
+    size_t push(Type type) {
+        Value value;
+        value.type = type;
+        value.size = 0;
+        tape_.push_back(value);
+        return tape_.size() - 1;
+    }
+
+    void skip() {
+        while (p_ < end_ && (*p_ == ' ' || *p_ == '\n' || *p_ == '\r' || *p_ == '\t'))
+            p_++;
+    }
+
+    bool value(int depth) {
+        skip();
+        if (p_ == end_)
+            return false;
+        switch (*p_) {
+        case '{': return object(depth + 1);
+        case '[': return array(depth + 1);
+        case '"': return string();
+        case 't': return literal("true", 4, TRUE);
+        case 'f': return literal("false", 5, FALSE);
+        case 'n': return literal("null", 4, NUL);
+        // Constants accepted by json.loads
+        case 'N': return constant("NaN", 3, NAN);
+        case 'I': return constant("Infinity", 8, HUGE_VAL);
+        case '-':
+            if (p_ + 1 < end_ && p_[1] == 'I') {
+                p_++;
+                return constant("Infinity", 8, -HUGE_VAL);
+            }
+            return number();
+        default: return number();
+        }
+    }
+
+    bool literal(const char * text, size_t len, Type type) {
+        if ((size_t) (end_ - p_) < len || memcmp(p_, text, len) != 0)
+            return false;
+        p_ += len;
+        push(type);
+        return true;
+    }
+
+    bool constant(const char * text, size_t len, double d) {
+        if (!literal(text, len, FLOAT))
+            return false;
+        tape_.back().v.d = d;
+        return true;
+    }
+
+    bool array(int depth) {
+        if (depth > MAX_DEPTH)
+            return false;
+        p_++;
+        const size_t idx = push(ARRAY);
+        skip();
+        if (p_ < end_ && *p_ == ']') {
+            p_++;
+            return true;
+        }
+        for (;;) {
+            if (!value(depth))
+                return false;
+            tape_[idx].size++;
+            skip();
+            if (p_ == end_)
+                return false;
+            if (*p_ == ']') {
+                p_++;
+                return true;
+            }
+            if (*p_++ != ',')
+                return false;
+        }
+    }
+
+    bool object(int depth) {
+        if (depth > MAX_DEPTH)
+            return false;
+        p_++;
+        const size_t idx = push(OBJECT);
+        skip();
+        if (p_ < end_ && *p_ == '}') {
+            p_++;
+            return true;
+        }
+        for (;;) {
+            skip();
+            if (p_ == end_ || *p_ != '"' || !string())
+                return false;
+            skip();
+            if (p_ == end_ || *p_++ != ':')
+                return false;
+            if (!value(depth))
+                return false;
+            tape_[idx].size++;
+            skip();
+            if (p_ == end_)
+                return false;
+            if (*p_ == '}') {
+                p_++;
+                return true;
+            }
+            if (*p_++ != ',')
+                return false;
+        }
+    }
+
+    bool string() {
+        const char * start = ++p_;
+        bool ascii = true;
+        const char * s = pySplJSONScan(p_, end_, ascii);
+        if (s == end_)
+            return false;
+
+        const size_t idx = push(STRING);
+        if (*s == '"') {
+            // No escapes, the string is in the document
+            Value & value = tape_[idx];
+            value.ascii = ascii;
+            value.escaped = false;
+            value.size = s - start;
+            value.v.offset = start - data_;
+            p_ = s + 1;
+            return true;
+        }
+
+        const size_t offset = text_.size();
+        for (;;) {
+            text_.append(p_, s - p_);
+            p_ = s;
+            if (p_ == end_)
+                return false;
+            if (*p_ == '"')
+                break;
+            // Control characters are not allowed
+            if (*p_ != '\\' || !escape(ascii))
+                return false;
+            s = pySplJSONScan(p_, end_, ascii);
+        }
+        p_++;
+        Value & value = tape_[idx];
+        value.ascii = ascii;
+        value.escaped = true;
+        value.size = text_.size() - offset;
+        value.v.offset = offset;
+        return true;
+    }
+
+    bool hex4(uint32_t & cp) {
+        if (end_ - p_ < 4)
+            return false;
+        cp = 0;
+        for (int i = 0; i < 4; i++) {
+            const char c = *p_++;
+            cp <<= 4;
+            if (c >= '0' && c <= '9')
+                cp |= c - '0';
+            else if (c >= 'a' && c <= 'f')
+                cp |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F')
+                cp |= c - 'A' + 10;
+            else
+                return false;
+        }
+        return true;
+    }
+
+    bool escape(bool & ascii) {
+        if (end_ - p_ < 2)
+            return false;
+        const char c = p_[1];
+        p_ += 2;
+        switch (c) {
+        case '"': text_ += '"'; return true;
+        case '\\': text_ += '\\'; return true;
+        case '/': text_ += '/'; return true;
+        case 'b': text_ += '\b'; return true;
+        case 'f': text_ += '\f'; return true;
+        case 'n': text_ += '\n'; return true;
+        case 'r': text_ += '\r'; return true;
+        case 't': text_ += '\t'; return true;
+        case 'u': break;
+        default: return false;
+        }
+
+        uint32_t cp;
+        if (!hex4(cp))
+            return false;
+        if (cp >= 0xD800 && cp < 0xE000) {
+            // Only a surrogate pair is accepted
+            uint32_t low;
+            if (cp >= 0xDC00 || end_ - p_ < 2 || p_[0] != '\\' || p_[1] != 'u')
+                return false;
+            p_ += 2;
+            if (!hex4(low) || low < 0xDC00 || low >= 0xE000)
+                return false;
+            cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+        }
+        if (cp < 0x80) {
+            text_ += (char) cp;
+            return true;
+        }
+        ascii = false;
+        if (cp < 0x800) {
+            text_ += (char) (0xC0 | (cp >> 6));
+        } else {
+            if (cp < 0x10000) {
+                text_ += (char) (0xE0 | (cp >> 12));
+            } else {
+                text_ += (char) (0xF0 | (cp >> 18));
+                text_ += (char) (0x80 | ((cp >> 12) & 0x3F));
+            }
+            text_ += (char) (0x80 | ((cp >> 6) & 0x3F));
+        }
+        text_ += (char) (0x80 | (cp & 0x3F));
+        return true;
+    }
+
+    bool digits() {
+        const char * start = p_;
+        while (p_ < end_ && *p_ >= '0' && *p_ <= '9')
+            p_++;
+        return p_ != start;
+    }
+
+    bool number() {
+        const char * start = p_;
+        const bool negative = *p_ == '-';
+        if (negative)
+            p_++;
+        if (p_ == end_)
+            return false;
+
+        // Integer part, no leading zeros
+        uint64_t n = 0;
+        int count = 0;
+        if (*p_ == '0') {
+            p_++;
+        } else if (*p_ >= '1' && *p_ <= '9') {
+            for (; p_ < end_ && *p_ >= '0' && *p_ <= '9'; p_++, count++) {
+                if (count < 19)
+                    n = n * 10 + (*p_ - '0');
+            }
+        } else {
+            return false;
+        }
+
+        bool integer = true;
+        if (p_ < end_ && *p_ == '.') {
+            p_++;
+            integer = false;
+            if (!digits())
+                return false;
+        }
+        if (p_ < end_ && (*p_ == 'e' || *p_ == 'E')) {
+            p_++;
+            integer = false;
+            if (p_ < end_ && (*p_ == '+' || *p_ == '-'))
+                p_++;
+            if (!digits())
+                return false;
+        }
+
+        if (integer) {
+            // Larger integers are loaded by json.loads
+            if (count > 19 || n > (uint64_t) INT64_MAX + negative)
+                return false;
+            push(INT);
+            tape_.back().v.i = negative ? (int64_t) (~n + 1) : (int64_t) n;
+            return true;
+        }
+
+        number_.assign(start, p_ - start);
+        push(FLOAT);
+        tape_.back().v.d = strtod_l(number_.c_str(), NULL, pySplJSONLocale());
+        return true;
+    }
+
+    PyObject * build(const char * data, size_t & i) {
+        const Value & value = tape_[i++];
+        switch (value.type) {
+        case NUL: return SplpyGeneral::getNone(NULL);
+        case FALSE: return PyBool_FromLong(0);
+        case TRUE: return PyBool_FromLong(1);
+        case INT: return PyLong_FromLong((long) value.v.i);
+        case FLOAT: return PyFloat_FromDouble(value.v.d);
+        case STRING:
+            return pySplUnicodeFromUTF8(
+                (value.escaped ? text_.data() : data) + value.v.offset,
+                value.size, value.ascii);
+        case ARRAY: {
+            PyObject * list = PyList_New(value.size);
+            if (list == NULL)
+                return NULL;
+            for (size_t n = 0; n < value.size; n++) {
+                PyObject * item = build(data, i);
+                if (item == NULL) {
+                    Py_DECREF(list);
+                    return NULL;
+                }
+                PyList_SET_ITEM(list, n, item);
+            }
+            return list;
+        }
+        case OBJECT: {
+            PyObject * dict = _PyDict_NewPresized(value.size);
+            if (dict == NULL)
+                return NULL;
+            for (size_t n = 0; n < value.size; n++) {
+                PyObject * key = build(data, i);
+                PyObject * item = key == NULL ? NULL : build(data, i);
+                int rc = item == NULL ? -1 : PyDict_SetItem(dict, key, item);
+                Py_XDECREF(key);
+                Py_XDECREF(item);
+                if (rc != 0) {
+                    Py_DECREF(dict);
+                    return NULL;
+                }
+            }
+            return dict;
+        }
+        }
+        return NULL;
+    }
+
+    uint64_t seq_;
+    const char * data_;
+    const char * p_;
+    const char * end_;
+    std::vector<Value> tape_;
+    // Unescaped strings
+    std::string text_;
+    // Floating point value being converted
+    std::string number_;
+};
+
+/**
+ * Encoder of Python objects as JSON producing the same
+ * text as json.dumps(value, ensure_ascii=False).
+ *
+ * Supports None, bool, int, float, str, list, tuple and
+ * dict with str keys, exact types only. Values containing
+ * any other object are serialized by json.dumps.
+ *
+ * Caller must hold the GIL.
+ */
+class SplpyJSONEncoder {
+  public:
+    // Deeper values are serialized by json.dumps
+    static const int MAX_DEPTH = 256;
+
+    SplpyJSONEncoder() {
+        PyObject * v;
+        none_ = Py_TYPE(v = SplpyGeneral::getNone(NULL)); Py_DECREF(v);
+        bool_ = Py_TYPE(v = PyBool_FromLong(1)); Py_DECREF(v);
+        int_ = Py_TYPE(v = PyLong_FromLong(0)); Py_DECREF(v);
+        float_ = Py_TYPE(v = PyFloat_FromDouble(0.0)); Py_DECREF(v);
+        str_ = Py_TYPE(v = PyUnicode_DecodeUTF8("", 0, NULL)); Py_DECREF(v);
+        list_ = Py_TYPE(v = PyList_New(0)); Py_DECREF(v);
+        tuple_ = Py_TYPE(v = PyTuple_New(0)); Py_DECREF(v);
+        dict_ = Py_TYPE(v = PyDict_New()); Py_DECREF(v);
+    }
+
+    /**
+     * Append the serialization of value to out, returning
+     * false if the value is not supported, out is then
+     * partially written.
+     */
+    bool encode(SPL::rstring & out, PyObject * value, int depth) {
+        PyTypeObject * type = Py_TYPE(value);
+        if (type == str_)
+            return encodeString(out, value);
+        if (type == int_) {
+            long v = PyLong_AsLong(value);
+            if (v == -1 && PyErr_Occurred()) {
+                PyErr_Clear();
+                PyObject * str = PyObject_Str(value);
+                if (str == NULL) {
+                    PyErr_Clear();
+                    return false;
+                }
+                Py_ssize_t size;
+                const char * digits = PyUnicode_AsUTF8AndSize(str, &size);
+                if (digits != NULL)
+                    out.append(digits, size);
+                Py_DECREF(str);
+                return digits != NULL;
+            }
+            char buf[24];
+            out.append(buf, snprintf(buf, sizeof(buf), "%ld", v));
+            return true;
+        }
+        if (type == float_) {
+            encodeFloat(out, PyFloat_AS_DOUBLE(value));
+            return true;
+        }
+        if (type == bool_) {
+            out.append(PyObject_IsTrue(value) ? "true" : "false");
+            return true;
+        }
+        if (type == none_) {
+            out.append("null");
+            return true;
+        }
+        if (++depth > MAX_DEPTH)
+            return false;
+        if (type == list_ || type == tuple_) {
+            const bool list = type == list_;
+            out += '[';
+            for (Py_ssize_t i = 0; i < (list ? PyList_GET_SIZE(value) : PyTuple_GET_SIZE(value)); i++) {
+                if (i != 0)
+                    out.append(", ");
+                if (!encode(out, list ? PyList_GET_ITEM(value, i) : PyTuple_GET_ITEM(value, i), depth))
+                    return false;
+            }
+            out += ']';
+            return true;
+        }
+        if (type == dict_) {
+            out += '{';
+            Py_ssize_t pos = 0;
+            PyObject * k;
+            PyObject * v;
+            bool first = true;
+            while (PyDict_Next(value, &pos, &k, &v)) {
+                if (Py_TYPE(k) != str_)
+                    return false;
+                if (!first)
+                    out.append(", ");
+                first = false;
+                if (!encodeString(out, k))
+                    return false;
+                out.append(": ");
+                if (!encode(out, v, depth))
+                    return false;
+            }
+            out += '}';
+            return true;
+        }
+        return false;
+    }
+
+  private:
+    bool encodeString(SPL::rstring & out, PyObject * value) {
+        const char * data;
+        Py_ssize_t size;
+        if (PyUnicode_IS_READY(value) && PyUnicode_IS_ASCII(value)) {
+            data = (const char *) PyUnicode_DATA(value);
+            size = PyUnicode_GET_LENGTH(value);
+        } else if ((data = PyUnicode_AsUTF8AndSize(value, &size)) == NULL) {
+            // Surrogates are left to json.dumps
+            PyErr_Clear();
+            return false;
+        }
+
+        out += '"';
+        const char * end = data + size;
+        bool ascii = true;
+        for (;;) {
+            const char * s = pySplJSONScan(data, end, ascii);
+            out.append(data, s - data);
+            if (s == end)
+                break;
+            const unsigned char c = *s;
+            switch (c) {
+            case '"': out.append("\\\""); break;
+            case '\\': out.append("\\\\"); break;
+            case '\b': out.append("\\b"); break;
+            case '\f': out.append("\\f"); break;
+            case '\n': out.append("\\n"); break;
+            case '\r': out.append("\\r"); break;
+            case '\t': out.append("\\t"); break;
+            default: {
+                char buf[8];
+                snprintf(buf, sizeof(buf), "\\u%04x", c);
+                out.append(buf, 6);
+            }
+            }
+            data = s + 1;
+        }
+        out += '"';
+        return true;
+    }
+
+    /**
+     * Append the float as repr() does, the shortest
+     * digits that convert back to the same value.
+     */
+    static void encodeFloat(SPL::rstring & out, double d) {
+        if (d != d) {
+            out.append("NaN");
+            return;
+        }
+        if (d == HUGE_VAL || d == -HUGE_VAL) {
+            out.append(d > 0 ? "Infinity" : "-Infinity");
+            return;
+        }
+
+        // Any value with 15 significant digits converts back to
+        // the same normal value so the shortest digits are the
+        // 15 digits without trailing zeros, otherwise 16 or 17
+        // digits. Subnormal values have fewer significant digits.
+        char digits[24];
+        int exp = 0;
+        int count = 0;
+        for (int precision = fabs(d) < DBL_MIN ? 1 : 15; precision <= 17; precision++) {
+            count = decimalDigits(d, precision, digits, exp);
+            if (precision == 17 || toDouble(d < 0, digits, count, exp) == d)
+                break;
+        }
+        while (count > 1 && digits[count - 1] == '0')
+            count--;
+
+        if (d < 0 || (d == 0 && signbit(d)))
+            out += '-';
+        if (exp >= -4 && exp < 16) {
+            if (exp < 0) {
+                out.append("0.");
+                out.append(-exp - 1, '0');
+                out.append(digits, count);
+            } else if (count > exp + 1) {
+                out.append(digits, exp + 1);
+                out += '.';
+                out.append(digits + exp + 1, count - exp - 1);
+            } else {
+                out.append(digits, count);
+                out.append(exp + 1 - count, '0');
+                out.append(".0");
+            }
+        } else {
+            out += digits[0];
+            if (count > 1) {
+                out += '.';
+                out.append(digits + 1, count - 1);
+            }
+            char buf[8];
+            out.append(buf, snprintf(buf, sizeof(buf), "e%c%02d", exp < 0 ? '-' : '+', exp < 0 ? -exp : exp));
+        }
+    }
+
+    // Set the significant digits of |d| rounded to precision
+    // digits and the decimal exponent of the first digit.
+    static int decimalDigits(double d, int precision, char * digits, int & exp) {
+        char buf[40];
+        snprintf(buf, sizeof(buf), "%.*e", precision - 1, d);
+        // Digits are read ignoring the locale's decimal point
+        int count = 0;
+        const char * p = buf;
+        for (; *p != 'e'; p++) {
+            if (*p >= '0' && *p <= '9')
+                digits[count++] = *p;
+        }
+        exp = atoi(p + 1);
+        return count;
+    }
+
+    static double toDouble(bool negative, const char * digits, int count, int exp) {
+        char buf[48];
+        snprintf(buf, sizeof(buf), "%s%c.%.*se%d", negative ? "-" : "",
+            digits[0], count - 1, digits + 1, exp);
+        return strtod_l(buf, NULL, pySplJSONLocale());
+    }
+
+    PyTypeObject * none_;
+    PyTypeObject * bool_;
+    PyTypeObject * int_;
+    PyTypeObject * float_;
+    PyTypeObject * str_;
+    PyTypeObject * list_;
+    PyTypeObject * tuple_;
+    PyTypeObject * dict_;
+};
+#endif
+
+/**
+ * JSON rstring attribute (CommonSchema.Json) passed
+ * to a Python function as the deserialized object.
+ *
+ * With Python 3 the document is parsed when the value is
+ * constructed, before the GIL is acquired, by a parser kept
+ * per thread. Holding the GIL object() then only builds
+ * the objects. Documents the parser does not accept, and
+ * all documents with Python 2, are loaded by json.loads.
+ */
+class SplpyJSON {
+  public:
+    explicit SplpyJSON(const SPL::rstring & value) : value_(value), seq_(0) {
+#if PY_MAJOR_VERSION == 3
+        SplpyJSONParser & p = parser();
+        if (p.parse(value.data(), value.size()))
+            seq_ = p.seq();
+#endif
+    }
+
+    /**
+     * The JSON document.
+     */
+    operator const SPL::rstring & () const {
+        return value_;
+    }
+
+    /**
+     * Return the deserialized object as a new reference.
+     * Caller must hold the GIL.
+     */
+    PyObject * object() const {
+#if PY_MAJOR_VERSION == 3
+        // Another document parsed on this thread since
+        // construction replaces the parsed values.
+        SplpyJSONParser & p = parser();
+        if (seq_ != 0 && p.seq() == seq_) {
+            PyObject * pyv = p.build(value_.data());
+            if (pyv != NULL)
+                return pyv;
+            PyErr_Clear();
+        }
+#endif
+        static PyObject * loads = NULL;
+        PyObject * function = SplpyGeneral::cachedFunction(loads, "json", "loads");
+        PyObject * pys = pySplValueToPyObject(value_);
+        if (pys == NULL)
+            throw SplpyExceptionInfo::pythonError("json");
+        PyObject * args = PyTuple_New(1);
+        PyTuple_SET_ITEM(args, 0, pys);
+        PyObject * pyv = PyObject_CallObject(function, args);
+        Py_DECREF(args);
+        if (pyv == NULL)
+            throw SplpyExceptionInfo::pythonError("json");
+        return pyv;
+    }
+
+  private:
+#if PY_MAJOR_VERSION == 3
+    static SplpyJSONParser & parser() {
+        static __thread SplpyJSONParser * parser = NULL;
+        if (parser == NULL)
+            parser = new SplpyJSONParser();
+        return *parser;
+    }
+#endif
+
+    const SPL::rstring & value_;
+    uint64_t seq_;
+};
+
+/**
+ * Set the rstring to the JSON serialization of value,
+ * as json.dumps(value, ensure_ascii=False).
+ * Caller must hold the GIL.
+ */
+inline void pySplJSONFromPyObject(SPL::rstring & splv, PyObject * value) {
+#if PY_MAJOR_VERSION == 3
+    static SplpyJSONEncoder encoder;
+    splv.clear();
+    if (encoder.encode(splv, value, 0))
+        return;
+#endif
+    static PyObject * dumps = NULL;
+    PyObject * function = SplpyGeneral::cachedFunction(dumps, "streamsx.topology.runtime", "_json_object_out");
+    PyObject * args = PyTuple_New(1);
+    Py_INCREF(value);
+    PyTuple_SET_ITEM(args, 0, value);
+    PyObject * json = PyObject_CallObject(function, args);
+    Py_DECREF(args);
+    if (json == NULL)
+        throw SplpyExceptionInfo::pythonError("json");
+    pySplValueFromPyObject(splv, json);
+    Py_DECREF(json);
+}
+
+}}
+
+#endif
@@ -32,13 +32,29 @@ using UTILS_NAMESPACE_QUALIFIER Mutex;
 
 class SplpyOp;
 
+/**
+ * Output an operator holds back from submission, such as a
+ * pending batch or tuples in a submit queue, that is submitted
+ * when a consistent region is drained.
+ */
+class SplpyOpDrain {
+ public:
+  virtual ~SplpyOpDrain() {}
+  // Submit all held output, called without the GIL.
+  virtual void drain() = 0;
+};
+
 /**
  * State handler interface definition, and do-nothing
- * base class.
+ * base class. Draining submits the operator's held output.
  */
 class SplpyOpStateHandler : public SPL::StateHandler {
+public:
+  SplpyOpStateHandler(SplpyOp * pyop) : pyop_(pyop) {}
+  virtual void drain();
 private:
   virtual Mutex * getMutex() { return NULL; }
+  SplpyOp * pyop_;
   friend class SplpyOp;
 };
 
@@ -65,17 +81,30 @@ class SplpyOpStateHandlerImpl : public SplpyOpStateHandler {
 
 class SplpyOp {
   public:
-      SplpyOp(SPL::Operator *op, const char * spl_setup_py) :
+      /**
+       * Setup Python for an operator, with subinterpreter
+       * true the operator executes in its own sub-interpreter.
+       */
+      SplpyOp(SPL::Operator *op, const char * spl_setup_py, bool subinterpreter = false) :
           op_(op),
           callable_(NULL),
           pydl_(NULL),
+          interp_(NULL),
+          gilMetrics_(NULL),
+          stageMetrics_(NULL),
           exc_suppresses(NULL),
           opc_(NULL),
           stateHandler(NULL),
-          stateHandlerMutex(NULL)
+          stateHandlerMutex(NULL),
+          drain_(NULL)
       {
           pydl_ = SplpySetup::loadCPython(spl_setup_py);
+          if (subinterpreter)
+              interp_ = SplpySetup::newInterpreter(pydl_, spl_setup_py);
+          if (SplpyGILMetrics::enabled())
+              gilMetrics_ = new SplpyGILMetrics(op);
 
+          SplpyInterpreter::Scope scope(interp_);
           SplpyGIL lock;
           SPL::rstring outDir(op->getPE().getOutputDirectory());
           PyObject * pyOutDir = pySplValueToPyObject(outDir);
@@ -89,26 +118,87 @@ class SplpyOp {
       virtual ~SplpyOp()
       {
         {
-          SplpyGIL lock;
+          SplpyInterpreter::Scope scope(interp_);
+          {
+            SplpyGIL lock;
 
-          if (callable_ != NULL)
-              Py_DECREF(callable_);
+            if (callable_ != NULL)
+                Py_DECREF(callable_);
+
+            if (opc_ != NULL)
+                Py_DECREF(opc_);
+          }
 
-          if (opc_ != NULL)
-              Py_DECREF(opc_);
+          delete stateHandler;
+          stateHandler = NULL;
+          stateHandlerMutex = NULL; // not owned by this class
         }
+        // Ends the sub-interpreter once its objects are released
+        delete interp_;
+        delete gilMetrics_;
+        delete stageMetrics_;
         if (pydl_ != NULL)
           (void) dlclose(pydl_);
-
-        delete stateHandler;
-        stateHandler = NULL;
-        stateHandlerMutex = NULL; // not owned by this class
       }
 
       SPL::Operator * op() {
          return op_;
       }
 
+      /**
+       * Sub-interpreter the operator executes in,
+       * NULL for the main interpreter. Each entry point
+       * into the operator binds it using a
+       * SplpyInterpreter::Scope.
+       */
+      SplpyInterpreter * interpreter() {
+         return interp_;
+      }
+
+      /**
+       * GIL metrics for the operator, NULL unless enabled.
+       * Each entry point into the operator binds them using a
+       * SplpyGILMetrics::Scope.
+       */
+      SplpyGILMetrics * gilMetrics() {
+         return gilMetrics_;
+      }
+
+      /**
+       * Measure the stages of processing a tuple, called by
+       * the constructor of an operator that creates a
+       * SplpyStageMetrics::Sample for each tuple it processes.
+       */
+      void setupStageMetrics() {
+         const uint32_t period = SplpyStageMetrics::period();
+         if (period != 0)
+             stageMetrics_ = new SplpyStageMetrics(op_, period);
+      }
+
+      /**
+       * Stage metrics for the operator, NULL unless setup.
+       */
+      SplpyStageMetrics * stageMetrics() {
+         return stageMetrics_;
+      }
+
+      /**
+       * Set the output held back by the operator that is
+       * submitted when a consistent region is drained.
+       * Ownership is not transferred.
+       */
+      void setDrain(SplpyOpDrain * drain) {
+         drain_ = drain;
+      }
+
+      /**
+       * Submit the operator's held output.
+       */
+      void drain() {
+         if (drain_ != NULL)
+             drain_->drain();
+      }
+
       void setCallable(PyObject * callable) {
         bool firstTime = (callable_ == NULL);
         callable_ = callable;
@@ -283,7 +373,7 @@ class SplpyOp {
           }
           else {
             SPLAPPTRC(L_DEBUG, "Creating nonfunctional state handler", "python");
-            stateHandler = new SplpyOpStateHandler;
+            stateHandler = new SplpyOpStateHandler(this);
             stateHandlerMutex = NULL;
           }
           SPLAPPTRC(L_DEBUG, "registerStateHandler", "python");
@@ -333,6 +423,15 @@ class SplpyOp {
       // Handle to libpythonX.Y.so
       void * pydl_;
 
+      // Sub-interpreter or NULL
+      SplpyInterpreter * interp_;
+
+      // GIL wait and hold metrics or NULL
+      SplpyGILMetrics * gilMetrics_;
+
+      // Tuple processing stage metrics or NULL
+      SplpyStageMetrics * stageMetrics_;
+
       // Number of exceptions suppressed by __exit__
       SPL::Metric *exc_suppresses;
 
@@ -341,10 +440,18 @@ class SplpyOp {
 
       SplpyOpStateHandler * stateHandler;
       Mutex * stateHandlerMutex;
+
+      // Output held back by the operator or NULL
+      SplpyOpDrain * drain_;
 };
 
+ void SplpyOpStateHandler::drain() {
+   SPLAPPTRC(L_DEBUG, "drain", "python");
+   pyop_->drain();
+ }
+
  // Steals reference to pickledCallable
- SplpyOpStateHandlerImpl::SplpyOpStateHandlerImpl(SplpyOp * pyop, PyObject * pickledCallable) : op(pyop), loads(), dumps(), pickledInitialCallable(pickledCallable), mutex_() {
+ SplpyOpStateHandlerImpl::SplpyOpStateHandlerImpl(SplpyOp * pyop, PyObject * pickledCallable) : SplpyOpStateHandler(pyop), op(pyop), loads(), dumps(), pickledInitialCallable(pickledCallable), mutex_() {
   // Load pickle.loads and pickle.dumps
   SplpyGIL lock;
   loads = SplpyGeneral::loadFunction("dill", "loads");
@@ -363,6 +470,7 @@ class SplpyOp {
    AutoMutex am(mutex_);
    SPL::blob bytes;
    {
+     SplpyInterpreter::Scope scope(op->interpreter());
      SplpyGIL lock;
      PyObject * ret = call(dumps, op->callable());
      if (!ret) {
@@ -382,6 +490,7 @@ class SplpyOp {
    // Restore the callable from an spl blob
    SPL::blob bytes;
    ckpt >> bytes;
+   SplpyInterpreter::Scope scope(op->interpreter());
    SplpyGIL lock;
    PyObject * pickle = pySplValueToPyObject(bytes);
    PyObject * ret = call(loads, pickle);
@@ -398,6 +507,7 @@ class SplpyOp {
  void SplpyOpStateHandlerImpl::resetToInitialState() {
    AutoMutex am(mutex_);
    SPLAPPTRC(L_DEBUG, "resetToInitialState", "python");
+   SplpyInterpreter::Scope scope(op->interpreter());
    SplpyGIL lock;
    PyObject * initialCallable = call(loads, pickledInitialCallable);
    if (!initialCallable) {
@@ -0,0 +1,234 @@
+/*
+# Licensed Materials - Property of IBM
+# Copyright IBM Corp. 2018
+*/
+
+/*
+ * Internal header file supporting Python
+ * for com.ibm.streamsx.topology.
+ *
+ * This is not part of any public api for
+ * the toolkit or toolkit with decorated
+ * SPL Python operators.
+ *
+ * Functionality related to holding serialized
+ * Python values in memory pooled by an operator.
+ */
+
+#ifndef __SPL__SPLPY_POOL_H
+#define __SPL__SPLPY_POOL_H
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+#include <vector>
+
+#include "splpy_general.h"
+
+namespace streamsx {
+  namespace topology {
+
+/**
+ * Pool of memory blocks for values held by an operator,
+ * such as the contents of a window, avoiding a heap
+ * allocation per value.
+ *
+ * Blocks are sized in powers of two from MIN_BLOCK to
+ * MAX_BLOCK bytes and are carved from slabs. A released
+ * block is kept on a free list for its size and reused by
+ * a later allocation of the same size class, slabs are only
+ * freed with the pool. Allocations larger than MAX_BLOCK
+ * use the heap directly.
+ *
+ * Allocation and release may be called from different
+ * threads, e.g. a window's eviction thread.
+ */
+class SplpyBytePool {
+  public:
+    SplpyBytePool() : slab_(NULL), free_(0) {
+        for (int i = 0; i < CLASSES; i++)
+            blocks_[i] = NULL;
+        pthread_mutex_init(&mutex_, NULL);
+    }
+
+    ~SplpyBytePool() {
+        for (size_t i = 0; i < slabs_.size(); i++)
+            ::free(slabs_[i]);
+        pthread_mutex_destroy(&mutex_);
+    }
+
+    /**
+     * Allocate size bytes.
+     */
+    void * allocate(size_t size) {
+        const int cls = sizeClass(size);
+        if (cls == CLASSES) {
+            Block * block = (Block *) ::malloc(sizeof(Block) + size);
+            if (block == NULL)
+                throw std::bad_alloc();
+            block->cls = cls;
+            return block + 1;
+        }
+
+        pthread_mutex_lock(&mutex_);
+        Block * block = blocks_[cls];
+        if (block != NULL) {
+            blocks_[cls] = block->next;
+        } else {
+            const size_t bytes = sizeof(Block) + (MIN_BLOCK << cls);
+            if (bytes > free_) {
+                slab_ = (char *) ::malloc(SLAB);
+                if (slab_ == NULL) {
+                    free_ = 0;
+                    pthread_mutex_unlock(&mutex_);
+                    throw std::bad_alloc();
+                }
+                slabs_.push_back(slab_);
+                free_ = SLAB;
+            }
+            block = (Block *) slab_;
+            slab_ += bytes;
+            free_ -= bytes;
+        }
+        pthread_mutex_unlock(&mutex_);
+
+        block->cls = cls;
+        return block + 1;
+    }
+
+    /**
+     * Release memory returned by allocate.
+     */
+    void release(void * data) {
+        Block * block = ((Block *) data) - 1;
+        const int cls = block->cls;
+        if (cls == CLASSES) {
+            ::free(block);
+            return;
+        }
+        pthread_mutex_lock(&mutex_);
+        block->next = blocks_[cls];
+        blocks_[cls] = block;
+        pthread_mutex_unlock(&mutex_);
+    }
+
+  private:
+    enum {
+        MIN_BLOCK = 64,
+        CLASSES = 11,
+        MAX_BLOCK = MIN_BLOCK << (CLASSES - 1),
+        SLAB = 1024 * 1024
+    };
+
+    // Header of a block, next links a released
+    // block on the free list for its size.
+    struct Block {
+        int64_t cls;
+        Block * next;
+    };
+
+    // Index of the smallest block size holding size bytes,
+    // CLASSES if it is larger than any block.
+    static int sizeClass(size_t size) {
+        if (size > MAX_BLOCK)
+            return CLASSES;
+        int cls = 0;
+        while ((size_t) (MIN_BLOCK << cls) < size)
+            cls++;
+        return cls;
+    }
+
+    Block * blocks_[CLASSES];
+
+    // Remaining space in the current slab.
+    char * slab_;
+    size_t free_;
+    std::vector<char *> slabs_;
+
+    pthread_mutex_t mutex_;
+};
+
+/**
+ * Python value held as its pickled bytes, the value
+ * being depickled when it is first required.
+ * A value that arrives as a Python object is held
+ * as the object.
+ *
+ * Allocated from a SplpyBytePool with the pickled
+ * bytes following the structure.
+ */
+struct SplpyPickledValue {
+    // Python value, NULL until depickled.
+    PyObject * object;
+    // Number of pickled bytes.
+    size_t size;
+
+    /**
+     * Create a value holding a copy of the pickled bytes.
+     */
+    static SplpyPickledValue * create(SplpyBytePool & pool,
+           const unsigned char * data, size_t size) {
+        SplpyPickledValue * pv = (SplpyPickledValue *)
+            pool.allocate(sizeof(SplpyPickledValue) + size);
+        pv->object = NULL;
+        pv->size = size;
+        memcpy(pv->bytes(), data, size);
+        return pv;
+    }
+
+    /**
+     * Create a value holding a Python object, stealing the reference.
+     */
+    static SplpyPickledValue * create(SplpyBytePool & pool, PyObject * object) {
+        SplpyPickledValue * pv = (SplpyPickledValue *)
+            pool.allocate(sizeof(SplpyPickledValue));
+        pv->object = object;
+        pv->size = 0;
+        return pv;
+    }
+
+    /**
+     * Release the value's object and memory.
+     * Caller must hold the GIL.
+     */
+    static void release(SplpyPickledValue * pv, SplpyBytePool & pool) {
+        Py_XDECREF(pv->object);
+        pool.release(pv);
+    }
+
+    /**
+     * The Python value, depickled using loads on first use,
+     * returning a borrowed reference.
+     * Caller must hold the GIL.
+     */
+    PyObject * value(PyObject * loads) {
+        if (object == NULL) {
+            PyObject * pyTuple = PyTuple_New(1);
+            PyTuple_SET_ITEM(pyTuple, 0, view());
+            object = SplpyGeneral::pyCallObject(loads, pyTuple);
+        }
+        return object;
+    }
+
+  private:
+    unsigned char * bytes() {
+        return (unsigned char *) (this + 1);
+    }
+
+    // Memory view of the pickled bytes, depickling copies
+    // all data so the view is not used after loads returns.
+    // Python 2 depickles from a copy of the bytes.
+    PyObject * view() {
+#if PY_MAJOR_VERSION == 3
+        return PyMemoryView_FromMemory((char *) bytes(), (Py_ssize_t) size, PyBUF_READ);
+#else
+        return PyBytes_FromStringAndSize((const char *) bytes(), (Py_ssize_t) size);
+#endif
+    }
+};
+
+}}
+
+#endif
@@ -0,0 +1,208 @@
+/*
+# Licensed Materials - Property of IBM
+# Copyright IBM Corp. 2018
+*/
+
+/*
+ * Internal header file supporting Python
+ * for com.ibm.streamsx.topology.
+ *
+ * This is not part of any public api for
+ * the toolkit or toolkit with decorated
+ * SPL Python operators.
+ *
+ * Functionality related to submitting an operator's
+ * output tuples from a thread of their own.
+ */
+
+#ifndef __SPL__SPLPY_QUEUE_H
+#define __SPL__SPLPY_QUEUE_H
+
+#include <pthread.h>
+#include <stdint.h>
+
+namespace streamsx {
+  namespace topology {
+
+/**
+ * Bounded queue of output tuples between the thread invoking
+ * an operator's Python callable (the producer) and a thread
+ * that submits the tuples (the consumer), so that submission,
+ * including the processing of fused downstream operators,
+ * overlaps with the next invocation of the callable.
+ *
+ * The queue is a ring where the producer only modifies the tail
+ * and the consumer only modifies the head, so neither takes a
+ * lock while the queue is neither empty nor full. Threads wait
+ * on a condition variable when there is nothing to consume, or
+ * when the queue is full so that a slow downstream throttles the
+ * producer. Multiple producer threads are serialized by a mutex.
+ *
+ * close() wakes all waiting threads, after which tuples
+ * put into the queue are discarded and front() returns NULL.
+ * Tuples left in a closed queue are removed by discard().
+ */
+template <class T>
+class SplpySubmitQueue {
+  public:
+    SplpySubmitQueue(uint32_t capacity) :
+        size_(capacity + 1), ring_(new T[capacity + 1]),
+        head_(0), tail_(0), waiters_(0), closed_(false), full_(0)
+    {
+        pthread_mutex_init(&producer_, NULL);
+        pthread_mutex_init(&mutex_, NULL);
+        pthread_cond_init(&cond_, NULL);
+    }
+
+    ~SplpySubmitQueue() {
+        pthread_cond_destroy(&cond_);
+        pthread_mutex_destroy(&mutex_);
+        pthread_mutex_destroy(&producer_);
+        delete[] ring_;
+    }
+
+    /**
+     * Number of tuples in the queue.
+     */
+    uint32_t depth() const {
+        return (tail_ + size_ - head_) % size_;
+    }
+
+    /**
+     * Number of times a producer waited for a full queue.
+     */
+    uint64_t full() const {
+        return full_;
+    }
+
+    /**
+     * Put a copy of tuple at the tail of the queue,
+     * waiting while the queue is full.
+     * Returns false if the queue is closed.
+     */
+    bool put(const T & tuple) {
+        pthread_mutex_lock(&producer_);
+        const uint32_t tail = tail_;
+        const uint32_t next = (tail + 1) % size_;
+        if (next == head_) {
+            full_++;
+            await(head_, next, true);
+        }
+        const bool open = !closed_;
+        if (open) {
+            ring_[tail] = tuple;
+            __sync_synchronize();
+            tail_ = next;
+            wake();
+        }
+        pthread_mutex_unlock(&producer_);
+        return open;
+    }
+
+    /**
+     * Wait until all tuples in the queue have been
+     * consumed, or the queue is closed.
+     */
+    void drain() {
+        pthread_mutex_lock(&producer_);
+        await(head_, tail_, false);
+        pthread_mutex_unlock(&producer_);
+    }
+
+    /**
+     * Tuple at the head of the queue, waiting while the
+     * queue is empty. The tuple remains in the queue until
+     * pop() is called. Returns NULL once the queue is closed.
+     * Must only be called by the consumer thread.
+     */
+    T * front() {
+        await(tail_, head_, true);
+        if (closed_)
+            return NULL;
+        __sync_synchronize();
+        return ring_ + head_;
+    }
+
+    /**
+     * Remove the tuple at the head of the queue.
+     * Must only be called by the consumer thread.
+     */
+    void pop() {
+        ring_[head_] = T();
+        __sync_synchronize();
+        head_ = (head_ + 1) % size_;
+        wake();
+    }
+
+    /**
+     * Remove the tuple at the head of a closed queue, so that
+     * resources it holds can be released. Returns false when
+     * the queue is empty. Must only be called once the consumer
+     * and producer threads have completed.
+     */
+    bool discard(T & tuple) {
+        if (head_ == tail_)
+            return false;
+        tuple = ring_[head_];
+        pop();
+        return true;
+    }
+
+    /**
+     * Close the queue, waking any waiting threads.
+     */
+    void close() {
+        pthread_mutex_lock(&mutex_);
+        closed_ = true;
+        pthread_cond_broadcast(&cond_);
+        pthread_mutex_unlock(&mutex_);
+    }
+
+  private:
+    /**
+     * Wait while (index == at) is equal and the queue is open,
+     * index being the head_ or tail_ modified by the other side.
+     */
+    void await(volatile uint32_t & index, uint32_t at, bool equal) {
+        if ((index == at) != equal || closed_)
+            return;
+        pthread_mutex_lock(&mutex_);
+        __sync_fetch_and_add(&waiters_, 1);
+        while ((index == at) == equal && !closed_)
+            pthread_cond_wait(&cond_, &mutex_);
+        __sync_fetch_and_sub(&waiters_, 1);
+        pthread_mutex_unlock(&mutex_);
+    }
+
+    /**
+     * Wake any thread waiting for the index just published.
+     */
+    void wake() {
+        __sync_synchronize();
+        if (waiters_ != 0) {
+            pthread_mutex_lock(&mutex_);
+            pthread_cond_broadcast(&cond_);
+            pthread_mutex_unlock(&mutex_);
+        }
+    }
+
+    const uint32_t size_;
+    T * const ring_;
+
+    // Next tuple to consume, modified by the consumer.
+    volatile uint32_t head_;
+    // Next free slot, modified by a producer.
+    volatile uint32_t tail_;
+
+    volatile uint32_t waiters_;
+    volatile bool closed_;
+    uint64_t full_;
+
+    pthread_mutex_t producer_;
+    pthread_mutex_t mutex_;
+    pthread_cond_t cond_;
+};
+
+}}
+
+#endif
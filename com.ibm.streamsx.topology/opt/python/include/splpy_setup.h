@@ -131,6 +131,50 @@ class SplpySetup {
         }
     }
 
+    /*
+     * Create a sub-interpreter for an operator, running the
+     * toolkit's spl_setup.py script in it. The main interpreter
+     * must have been started by loadCPython.
+     *
+     * Each interpreter has its own instance of the _streamsx_ec
+     * module and its own classes used for SPL types.
+     */
+    static SplpyInterpreter * newInterpreter(void * pydl, const char* spl_setup_py_path) {
+        PyGILState_STATE gstate = PyGILState_Ensure();
+        PyThreadState * main = PyThreadState_Get();
+
+        PyThreadState * ts = Py_NewInterpreter();
+        if (ts == NULL) {
+            PyGILState_Release(gstate);
+            throw SplpyGeneral::generalException("setup",
+                        "Python sub-interpreter could not be created");
+        }
+
+        // Setup executes in the new interpreter
+        // with its thread state current.
+        SplpyInterpreter * interp = new SplpyInterpreter(ts);
+        try {
+            SplpyInterpreter::Scope scope(interp);
+#if PY_MAJOR_VERSION == 2
+            init_streamsx_ec();
+#endif
+            runSplSetup(pydl, spl_setup_py_path);
+            setupClasses();
+        } catch (...) {
+            interp->release();
+            PyEval_RestoreThread(main);
+            PyGILState_Release(gstate);
+            delete interp;
+            throw;
+        }
+        interp->release();
+        PyEval_RestoreThread(main);
+        PyGILState_Release(gstate);
+
+        SPLAPPTRC(L_INFO, "Created Python sub-interpreter", "python");
+        return interp;
+    }
+
    static void setupClasses() {
        SplpyGIL lock;
        SplpyGeneral::timestampClass(
@@ -0,0 +1,498 @@
+/*
+# Licensed Materials - Property of IBM
+# Copyright IBM Corp. 2018
+*/
+
+/*
+ * Internal header file supporting Python
+ * for com.ibm.streamsx.topology.
+ *
+ * This is not part of any public api for
+ * the toolkit or toolkit with decorated
+ * SPL Python operators.
+ *
+ * Functionality related to passing pickled Python
+ * objects between PEs on the same host through
+ * shared memory.
+ */
+
+#ifndef __SPL__SPLPY_SHM_H
+#define __SPL__SPLPY_SHM_H
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+#include <deque>
+#include <map>
+
+#include "splpy_general.h"
+
+/**
+ * Structure representing a SPL tuple containing a handle to
+ * a pickled value in a shared memory arena (SplpyShmArena).
+ * token identifies the arena's segment, segment names are
+ * only unique on a host.
+ */
+#define STREAMSX_TPP_SHM ((unsigned char) 0x8E)
+#define STREAMSX_SHM_NAME_MAX 32
+#define STREAMSX_SHM_PREFIX "streamsx.py."
+struct __SPLTuplePyShm {
+    unsigned char fmt;
+    char name[STREAMSX_SHM_NAME_MAX];
+    uint64_t offset;
+    uint64_t size;
+    uint64_t seq;
+    uint64_t token;
+};
+
+namespace streamsx {
+  namespace topology {
+
+/*
+ * Start of a shared memory segment, token is a
+ * random value chosen when the segment is created.
+ */
+struct SplpyShmSegment {
+    uint64_t magic;
+    uint64_t size;
+    uint64_t token;
+};
+#define SPLPY_SHM_MAGIC ((uint64_t) 0x53504c5059534d31ULL)
+
+/*
+ * Header of a block within a segment, followed by the pickled bytes.
+ * refs is the number of consumers that have not yet released
+ * the block, seq identifies the value the block holds.
+ */
+struct SplpyShmBlock {
+    volatile int32_t refs;
+    uint32_t reserved;
+    volatile uint64_t seq;
+};
+
+/**
+ * Arena in a shared memory segment used by an operator
+ * to pass pickled values to downstream Python operators
+ * in other PEs on the same host.
+ *
+ * A pickled value is copied once into a block in the
+ * arena and the SPL tuple only carries a handle to it
+ * (__SPLTuplePyShm). Each consumer releases the block
+ * once it has depickled the value, and the block is
+ * reclaimed once all consumers have released it.
+ *
+ * Blocks are allocated in order from a ring and reclaimed
+ * in the same order. When the arena is full the value is
+ * passed in the tuple as pickled bytes, as it is when the
+ * value is small. A block not released after LEASE seconds
+ * (for example a consumer PE restarted) is abandoned when its
+ * space is needed, a consumer then fails to use its handle.
+ *
+ * The segment is removed when the arena is deleted. Segments
+ * left by PEs that terminated without deleting their arenas
+ * are removed when an arena is first created by a process.
+ */
+class SplpyShmArena {
+   public:
+        // Smaller values are passed in the tuple
+        static const size_t MIN_SIZE = 1024;
+        static const time_t LEASE = 60;
+
+        /**
+         * Create an arena of size bytes where each value
+         * is released by refs consumers.
+         * Returns NULL if the shared memory segment cannot
+         * be created, values are then passed in the tuple.
+         */
+        static SplpyShmArena * create(size_t size, int32_t refs) {
+            static uint32_t count;
+            const uint32_t n = __sync_fetch_and_add(&count, 1);
+            if (n == 0)
+                removeOrphans();
+
+            char name[STREAMSX_SHM_NAME_MAX];
+            snprintf(name, sizeof(name), "/" STREAMSX_SHM_PREFIX "%d.%u",
+                (int) getpid(), n);
+
+            size += sizeof(SplpyShmSegment);
+            int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+            if (fd == -1) {
+                SPLAPPTRC(L_WARN, "Shared memory not available: " << name << ": " << strerror(errno), "python");
+                return NULL;
+            }
+            void * addr = MAP_FAILED;
+            if (ftruncate(fd, size) == 0)
+                addr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            close(fd);
+            if (addr == MAP_FAILED) {
+                SPLAPPTRC(L_WARN, "Shared memory not available: " << name << ": " << strerror(errno), "python");
+                shm_unlink(name);
+                return NULL;
+            }
+            SPLAPPTRC(L_INFO, "Shared memory arena: " << name << " size: " << size, "python");
+            return new SplpyShmArena(name, (char *) addr, size, refs);
+        }
+
+        ~SplpyShmArena() {
+            munmap(base_, size_);
+            shm_unlink(name_.c_str());
+        }
+
+        /**
+         * Copy the pickled bytes value into the arena and
+         * set the blob to its handle.
+         * Returns false leaving the blob unmodified if the
+         * value is small or there is no space for it.
+         */
+        bool put(SPL::blob & splv, PyObject * value) {
+            const char * bytes = PyBytes_AsString(value);
+            if (bytes == NULL) {
+                throw SplpyExceptionInfo::dataConversion("blob");
+            }
+            const size_t size = PyBytes_GET_SIZE(value);
+            if (size < MIN_SIZE)
+                return false;
+
+            const uint64_t need = (sizeof(SplpyShmBlock) + size + 15) & ~((uint64_t) 15);
+
+            __SPLTuplePyShm handle;
+            {
+                UTILS_NAMESPACE_QUALIFIER AutoMutex am(mutex_);
+                reclaim();
+                if (!allocate(need, handle.offset)) {
+                    if (!abandon() || !allocate(need, handle.offset))
+                        return false;
+                }
+
+                SplpyShmBlock * block = (SplpyShmBlock *) (base_ + handle.offset);
+                memcpy(block + 1, bytes, size);
+                block->seq = handle.seq = ++seq_;
+                block->refs = refs_;
+                __sync_synchronize();
+
+                Live live = {handle.offset, need, handle.seq, time(NULL)};
+                live_.push_back(live);
+            }
+
+            handle.fmt = STREAMSX_TPP_SHM;
+            memset(handle.name, 0, sizeof(handle.name));
+            strncpy(handle.name, name_.c_str(), sizeof(handle.name) - 1);
+            handle.size = size;
+            handle.token = token_;
+            splv.setData((unsigned char const *) &handle, sizeof(handle));
+            return true;
+        }
+
+   private:
+        SplpyShmArena(const char * name, char * base, size_t size, int32_t refs) :
+            name_(name), base_(base), size_(size), refs_(refs),
+            token_(randomToken()), head_(sizeof(SplpyShmSegment)), seq_(0) {
+            SplpyShmSegment * segment = (SplpyShmSegment *) base_;
+            segment->magic = SPLPY_SHM_MAGIC;
+            segment->size = size;
+            segment->token = token_;
+        }
+
+        static uint64_t randomToken() {
+            uint64_t token = 0;
+            int fd = open("/dev/urandom", O_RDONLY);
+            if (fd != -1) {
+                if (read(fd, &token, sizeof(token)) != sizeof(token))
+                    token = 0;
+                close(fd);
+            }
+            if (token == 0) {
+                struct timespec ts;
+                clock_gettime(CLOCK_REALTIME, &ts);
+                token = ((uint64_t) ts.tv_nsec << 32) ^ (uint64_t) ts.tv_sec
+                      ^ ((uint64_t) getpid() << 16) ^ (uint64_t) (uintptr_t) &token;
+            }
+            return token;
+        }
+
+        // Remove segments owned by this user created by
+        // processes that no longer exist.
+        static void removeOrphans() {
+            DIR * dir = opendir("/dev/shm");
+            if (dir == NULL)
+                return;
+            const size_t plen = strlen(STREAMSX_SHM_PREFIX);
+            struct dirent * entry;
+            while ((entry = readdir(dir)) != NULL) {
+                if (strncmp(entry->d_name, STREAMSX_SHM_PREFIX, plen) != 0)
+                    continue;
+                const int pid = atoi(entry->d_name + plen);
+                if (pid <= 0 || kill(pid, 0) == 0 || errno != ESRCH)
+                    continue;
+                struct stat st;
+                const std::string name = std::string("/dev/shm/") + entry->d_name;
+                if (stat(name.c_str(), &st) != 0 || st.st_uid != geteuid())
+                    continue;
+                if (shm_unlink(name.c_str() + strlen("/dev/shm")) == 0)
+                    SPLAPPTRC(L_INFO, "Removed orphaned shared memory segment: " << entry->d_name, "python");
+            }
+            closedir(dir);
+        }
+
+        SplpyShmBlock * block(uint64_t offset) {
+            return (SplpyShmBlock *) (base_ + offset);
+        }
+
+        // Reclaim blocks released by all consumers, in order.
+        void reclaim() {
+            while (!live_.empty() && block(live_.front().offset)->refs <= 0)
+                live_.pop_front();
+        }
+
+        // Abandon the oldest block if its lease has expired.
+        bool abandon() {
+            if (live_.empty() || time(NULL) - live_.front().created < LEASE)
+                return false;
+            Live & oldest = live_.front();
+            SPLAPPTRC(L_WARN, "Shared memory arena: " << name_ << " abandoning unreleased block: " << oldest.seq, "python");
+            block(oldest.offset)->seq = 0;
+            __sync_synchronize();
+            live_.pop_front();
+            reclaim();
+            return true;
+        }
+
+        // Allocate need bytes in the ring after head_.
+        // Caller must hold mutex_.
+        bool allocate(uint64_t need, uint64_t & offset) {
+            const uint64_t start = sizeof(SplpyShmSegment);
+            if (live_.empty())
+                head_ = start;
+            const uint64_t tail = live_.empty() ? head_ : live_.front().offset;
+
+            if (live_.empty() || head_ > tail) {
+                // Free space is after head_ and before tail
+                if (head_ + need <= size_)
+                    offset = head_;
+                else if (start + need <= tail)
+                    offset = start;
+                else
+                    return false;
+            } else if (head_ + need <= tail) {
+                offset = head_;
+            } else {
+                return false;
+            }
+            head_ = offset + need;
+            return true;
+        }
+
+        struct Live {
+            uint64_t offset;
+            uint64_t size;
+            uint64_t seq;
+            time_t created;
+        };
+
+        const std::string name_;
+        char * const base_;
+        const size_t size_;
+        const int32_t refs_;
+        const uint64_t token_;
+
+        uint64_t head_;
+        uint64_t seq_;
+        std::deque<Live> live_;
+        UTILS_NAMESPACE_QUALIFIER Mutex mutex_;
+};
+
+/**
+ * Reference by a consumer to a pickled value in a shared
+ * memory arena in another PE on the same host, from the handle
+ * in an SPL tuple. The value is released by the consumer
+ * when the reference goes out of scope.
+ *
+ * Segments are mapped on first use. The segment must have the
+ * handle's token, a segment with the same name on this host
+ * created by a different producer is never used.
+ * A mapped segment that has since been removed or replaced,
+ * for example when its producer PE restarted, is unmapped
+ * when a segment is next mapped once no references use it.
+ */
+class SplpyShmRef {
+   public:
+        SplpyShmRef(const SPL::blob & pyo) : block_(NULL), segment_(NULL) {
+            const __SPLTuplePyShm * handle = (const __SPLTuplePyShm *) pyo.getData();
+            if (pyo.getSize() != sizeof(__SPLTuplePyShm)) {
+                throw SPL::SPLRuntimeDeserializationException("SplpyShmRef", "Invalid blob");
+            }
+            segment_ = acquire(handle->name, handle->token);
+            if (handle->offset < sizeof(SplpyShmSegment)
+                 || handle->offset + sizeof(SplpyShmBlock) + handle->size > segment_->size) {
+                release();
+                throw SPL::SPLRuntimeDeserializationException("SplpyShmRef", "Invalid handle");
+            }
+            block_ = (SplpyShmBlock *) (segment_->base + handle->offset);
+            seq_ = handle->seq;
+            size_ = handle->size;
+            if (block_->seq != seq_) {
+                block_ = NULL;
+                release();
+                throw SplpyGeneral::generalException("shm",
+                    std::string("Shared memory value no longer available: ") + handle->name);
+            }
+        }
+        ~SplpyShmRef() {
+            if (block_ != NULL && block_->seq == seq_)
+                __sync_sub_and_fetch(&block_->refs, 1);
+            release();
+        }
+
+        const unsigned char * data() const {
+            return (const unsigned char *) (block_ + 1);
+        }
+        size_t size() const {
+            return size_;
+        }
+
+        /**
+         * Memory view of the pickled bytes,
+         * caller must hold the GIL.
+         */
+        PyObject * view() const {
+#if PY_MAJOR_VERSION == 3
+            return PyMemoryView_FromMemory((char *) data(), (Py_ssize_t) size_, PyBUF_READ);
+#else
+            Py_buffer buf;
+            PyBuffer_FillInfo(&buf, NULL, (void *) data(), (Py_ssize_t) size_, 1, PyBUF_SIMPLE);
+            return PyMemoryView_FromBuffer(&buf);
+#endif
+        }
+
+        /**
+         * Number of segments mapped by this process.
+         */
+        static size_t mappedSegments() {
+            UTILS_NAMESPACE_QUALIFIER AutoMutex am(mutex());
+            return segments().size();
+        }
+
+   private:
+        struct Segment {
+            std::string name;
+            char * base;
+            size_t size;
+            ino_t ino;
+            // Number of references using the segment.
+            volatile int32_t users;
+        };
+        typedef std::map<std::pair<std::string, uint64_t>, Segment> Segments;
+
+        static UTILS_NAMESPACE_QUALIFIER Mutex & mutex() {
+            static UTILS_NAMESPACE_QUALIFIER Mutex mutex;
+            return mutex;
+        }
+        static Segments & segments() {
+            static Segments segments;
+            return segments;
+        }
+
+        void release() {
+            if (segment_ != NULL)
+                __sync_sub_and_fetch(&segment_->users, 1);
+            segment_ = NULL;
+        }
+
+        // Use the segment with a name and token,
+        // mapping it on its first use.
+        static Segment * acquire(const char * name, uint64_t token) {
+            UTILS_NAMESPACE_QUALIFIER AutoMutex am(mutex());
+            Segments & mapped = segments();
+            const std::string key(name, strnlen(name, STREAMSX_SHM_NAME_MAX));
+            Segments::iterator it = mapped.find(std::make_pair(key, token));
+            if (it != mapped.end()) {
+                __sync_add_and_fetch(&it->second.users, 1);
+                return &it->second;
+            }
+
+            unmapStale(mapped);
+
+            Segment segment;
+            segment.name = key;
+            segment.base = NULL;
+            segment.size = 0;
+            segment.ino = 0;
+            segment.users = 1;
+            int fd = shm_open(key.c_str(), O_RDWR, 0);
+            if (fd != -1) {
+                struct stat st;
+                if (fstat(fd, &st) == 0 && (size_t) st.st_size >= sizeof(SplpyShmSegment)) {
+                    void * addr = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                    if (addr != MAP_FAILED) {
+                        segment.base = (char *) addr;
+                        segment.size = st.st_size;
+                        segment.ino = st.st_ino;
+                    }
+                }
+                close(fd);
+            }
+            if (segment.base != NULL) {
+                const SplpyShmSegment * header = (const SplpyShmSegment *) segment.base;
+                if (header->magic != SPLPY_SHM_MAGIC || header->token != token) {
+                    munmap(segment.base, segment.size);
+                    throw SplpyGeneral::generalException("shm",
+                        "Shared memory segment " + key + " was not created by the producer of the value, shared memory requires PEs on the same host.");
+                }
+            }
+            if (segment.base == NULL) {
+                throw SplpyGeneral::generalException("shm",
+                    "Shared memory segment " + key + " not available, shared memory requires PEs on the same host.");
+            }
+            SPLAPPTRC(L_DEBUG, "Mapped shared memory arena: " << key, "python");
+            return &(mapped[std::make_pair(key, token)] = segment);
+        }
+
+        // Unmap segments not in use that have been removed
+        // or replaced by a segment with the same name.
+        // Caller must hold mutex().
+        static void unmapStale(Segments & mapped) {
+            for (Segments::iterator it = mapped.begin(); it != mapped.end(); ) {
+                Segment & segment = it->second;
+                bool stale = segment.users == 0;
+                if (stale) {
+                    int fd = shm_open(segment.name.c_str(), O_RDONLY, 0);
+                    if (fd != -1) {
+                        struct stat st;
+                        stale = fstat(fd, &st) != 0 || st.st_ino != segment.ino;
+                        close(fd);
+                    }
+                }
+                if (stale) {
+                    SPLAPPTRC(L_DEBUG, "Unmapped shared memory arena: " << segment.name, "python");
+                    munmap(segment.base, segment.size);
+                    mapped.erase(it++);
+                } else {
+                    ++it;
+                }
+            }
+        }
+
+        SplpyShmBlock * block_;
+        Segment * segment_;
+        uint64_t seq_;
+        size_t size_;
+};
+
+/**
+ * Set the blob to a pickled value, passing it through
+ * the arena if one is set and the value fits.
+ */
+inline void pySplValueFromPyObject(SPL::blob & splv, PyObject * value, SplpyShmArena * shm) {
+    if (shm == NULL || !shm->put(splv, value))
+        pySplValueFromPyObject(splv, value);
+}
+
+}}
+
+#endif
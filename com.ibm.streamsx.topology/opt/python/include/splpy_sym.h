@@ -72,6 +72,8 @@ typedef PyGILState_STATE (*__splpy_gil_v_fp)(void);
 typedef void (*__splpy_v_gil_fp)(PyGILState_STATE);
 typedef PyThreadState * (*__splpy_ts_v_fp)(void);
 typedef void (*__splpy_v_ts_fp)(PyThreadState *);
+typedef PyThreadState * (*__splpy_ts_ts_fp)(PyThreadState *);
+typedef PyThreadState * (*__splpy_ts_is_fp)(PyInterpreterState *);
 
 extern "C" {
   static __splpy_gil_v_fp __spl_fp_PyGILState_Ensure;
@@ -98,17 +100,61 @@ extern "C" {
 #pragma weak PyEval_SaveThread = __spl_fi_PyEval_SaveThread
 #pragma weak PyEval_RestoreThread = __spl_fi_PyEval_RestoreThread
 
+/*
+ * Sub-interpreters and thread states
+ */
+extern "C" {
+  static __splpy_ts_v_fp __spl_fp_Py_NewInterpreter;
+  static __splpy_v_ts_fp __spl_fp_Py_EndInterpreter;
+  static __splpy_ts_v_fp __spl_fp_PyThreadState_Get;
+  static __splpy_ts_ts_fp __spl_fp_PyThreadState_Swap;
+  static __splpy_ts_is_fp __spl_fp_PyThreadState_New;
+  static __splpy_v_ts_fp __spl_fp_PyThreadState_Clear;
+  static __splpy_v_ts_fp __spl_fp_PyThreadState_Delete;
+
+  static PyThreadState * __spl_fi_Py_NewInterpreter() {
+     return __spl_fp_Py_NewInterpreter();
+  }
+  static void __spl_fi_Py_EndInterpreter(PyThreadState * state) {
+     __spl_fp_Py_EndInterpreter(state);
+  }
+  static PyThreadState * __spl_fi_PyThreadState_Get() {
+     return __spl_fp_PyThreadState_Get();
+  }
+  static PyThreadState * __spl_fi_PyThreadState_Swap(PyThreadState * state) {
+     return __spl_fp_PyThreadState_Swap(state);
+  }
+  static PyThreadState * __spl_fi_PyThreadState_New(PyInterpreterState * interp) {
+     return __spl_fp_PyThreadState_New(interp);
+  }
+  static void __spl_fi_PyThreadState_Clear(PyThreadState * state) {
+     __spl_fp_PyThreadState_Clear(state);
+  }
+  static void __spl_fi_PyThreadState_Delete(PyThreadState * state) {
+     __spl_fp_PyThreadState_Delete(state);
+  }
+};
+#pragma weak Py_NewInterpreter = __spl_fi_Py_NewInterpreter
+#pragma weak Py_EndInterpreter = __spl_fi_Py_EndInterpreter
+#pragma weak PyThreadState_Get = __spl_fi_PyThreadState_Get
+#pragma weak PyThreadState_Swap = __spl_fi_PyThreadState_Swap
+#pragma weak PyThreadState_New = __spl_fi_PyThreadState_New
+#pragma weak PyThreadState_Clear = __spl_fi_PyThreadState_Clear
+#pragma weak PyThreadState_Delete = __spl_fi_PyThreadState_Delete
+
 /*
  * String handling
  */
 typedef PyObject* (*__splpy_udu_fp)(const char *, Py_ssize_t, const char *);
 typedef PyObject* (*__splpy_uaus_fp)(PyObject *);
+typedef PyObject* (*__splpy_bfsas_fp)(const char *, Py_ssize_t);
 
 extern "C" {
   static __splpy_p_p_fp __spl_fp_PyObject_Str;
   static __splpy_udu_fp __spl_fp_PyUnicode_DecodeUTF8;
   static __splpy_uaus_fp __spl_fp_PyUnicode_AsUTF8String;
   static __splpy_c_p_fp __spl_fp_PyBytes_AsString;
+  static __splpy_bfsas_fp __spl_fp_PyBytes_FromStringAndSize;
 
   static PyObject * __spl_fi_PyObject_Str(PyObject *v) {
      return __spl_fp_PyObject_Str(v);
@@ -122,6 +168,9 @@ extern "C" {
   static char * __spl_fi_PyBytes_AsString(PyObject * o) {
      return __spl_fp_PyBytes_AsString(o);
   }
+  static PyObject * __spl_fi_PyBytes_FromStringAndSize(const char *v, Py_ssize_t len) {
+     return __spl_fp_PyBytes_FromStringAndSize(v, len);
+  }
 }
 #pragma weak PyObject_Str = __spl_fi_PyObject_Str
 
@@ -129,41 +178,60 @@ extern "C" {
 #pragma weak PyUnicode_DecodeUTF8 = __spl_fi_PyUnicode_DecodeUTF8
 #pragma weak PyUnicode_AsUTF8String = __spl_fi_PyUnicode_AsUTF8String
 #pragma weak PyBytes_AsString = __spl_fi_PyBytes_AsString
+#pragma weak PyBytes_FromStringAndSize = __spl_fi_PyBytes_FromStringAndSize
 #else
 // In Python2 the original functions (e.g. PyUnicode_DecodeUTF8)
 // are #defined to different functions and hence symbols.
 #pragma weak PyUnicodeUCS4_DecodeUTF8 = __spl_fi_PyUnicode_DecodeUTF8
 #pragma weak PyUnicodeUCS4_AsUTF8String = __spl_fi_PyUnicode_AsUTF8String
 #pragma weak PyString_AsString = __spl_fi_PyBytes_AsString
+#pragma weak PyString_FromStringAndSize = __spl_fi_PyBytes_FromStringAndSize
 #endif
 
 #if PY_MAJOR_VERSION == 3
 typedef char * (*__splpy_uauas_fp)(PyObject *, Py_ssize_t);
 typedef PyObject * (*__splpy_mvfm_fp)(char *, Py_ssize_t, int);
+typedef PyObject * (*__splpy_un_fp)(Py_ssize_t, Py_UCS4);
+typedef void (*__splpy_uiip_fp)(PyObject **);
 extern "C" {
   static __splpy_uauas_fp __spl_fp_PyUnicode_AsUTF8AndSize;
   static __splpy_mvfm_fp __spl_fp_PyMemoryView_FromMemory;
+  static __splpy_un_fp __spl_fp_PyUnicode_New;
+  static __splpy_uiip_fp __spl_fp_PyUnicode_InternInPlace;
   static char * __spl_fi_PyUnicode_AsUTF8AndSize(PyObject * o, Py_ssize_t size) {
      return __spl_fp_PyUnicode_AsUTF8AndSize(o, size);
   }
   static PyObject * __spl_fi_PyMemoryView_FromMemory(char *mem, Py_ssize_t size, int flags) {
      return __spl_fp_PyMemoryView_FromMemory(mem, size, flags);
   }
+  static PyObject * __spl_fi_PyUnicode_New(Py_ssize_t size, Py_UCS4 maxchar) {
+     return __spl_fp_PyUnicode_New(size, maxchar);
+  }
+  static void __spl_fi_PyUnicode_InternInPlace(PyObject **p) {
+     __spl_fp_PyUnicode_InternInPlace(p);
+  }
 }
 #pragma weak PyUnicode_AsUTF8AndSize = __spl_fi_PyUnicode_AsUTF8AndSize
 #pragma weak PyMemoryView_FromMemory = __spl_fi_PyMemoryView_FromMemory
+#pragma weak PyUnicode_New = __spl_fi_PyUnicode_New
+#pragma weak PyUnicode_InternInPlace = __spl_fi_PyUnicode_InternInPlace
 
 #else
 typedef int (*__splpy_sasas_fp)(PyObject *, char **, Py_ssize_t *);
-typedef PyObject * (*__splpy_mvfb_fp)(Py_buffer *);
-typedef int (*__splpy_bfi_fp)(Py_buffer *, PyObject *, void *, Py_ssize_t, int, int);
 extern "C" {
   static __splpy_sasas_fp __spl_fp_PyString_AsStringAndSize;
-  static __splpy_mvfb_fp __spl_fp_PyMemoryView_FromBuffer;
-  static __splpy_bfi_fp __spl_fp_PyBuffer_FillInfo;
   static int __spl_fi_PyString_AsStringAndSize(PyObject * o, char ** buf, Py_ssize_t *size) {
      return __spl_fp_PyString_AsStringAndSize(o, buf, size);
   }
+}
+#pragma weak PyString_AsStringAndSize = __spl_fi_PyString_AsStringAndSize
+#endif
+
+typedef PyObject * (*__splpy_mvfb_fp)(Py_buffer *);
+typedef int (*__splpy_bfi_fp)(Py_buffer *, PyObject *, void *, Py_ssize_t, int, int);
+extern "C" {
+  static __splpy_mvfb_fp __spl_fp_PyMemoryView_FromBuffer;
+  static __splpy_bfi_fp __spl_fp_PyBuffer_FillInfo;
   static PyObject * __spl_fi_PyMemoryView_FromBuffer(Py_buffer *buf) {
      return __spl_fp_PyMemoryView_FromBuffer(buf);
   }
@@ -171,10 +239,8 @@ extern "C" {
      return __spl_fp_PyBuffer_FillInfo(view, o, buf, len, readonly, flags);
   }
 }
-#pragma weak PyString_AsStringAndSize = __spl_fi_PyString_AsStringAndSize
 #pragma weak PyMemoryView_FromBuffer = __spl_fi_PyMemoryView_FromBuffer
 #pragma weak PyBuffer_FillInfo = __spl_fi_PyBuffer_FillInfo
-#endif
 
 /*
  * Loading modules, running code
@@ -183,6 +249,7 @@ extern "C" {
 typedef PyObject* (*__splpy_ogas_fp)(PyObject *, const char *);
 typedef int (*__splpy_ohas_fp)(PyObject *, const char *);
 typedef int (*__splpy_rssf_fp)(const char *, PyCompilerFlags *);
+typedef int (*__splpy_tr_fp)(PyTypeObject *);
 #if PY_MAJOR_VERSION == 3
 typedef PyObject* (*__splpy_mc2_fp)(PyModuleDef *, int);
 typedef int (*__splpy_sam_fp)(PyObject *, PyModuleDef *);
@@ -199,6 +266,8 @@ extern "C" {
   static __splpy_p_pp_fp __spl_fp_PyObject_CallObject;
   static __splpy_i_p_fp __spl_fp_PyCallable_Check;
   static __splpy_p_p_fp __spl_fp_PyImport_Import;
+  static __splpy_tr_fp __spl_fp_PyType_Ready;
+  static __splpy_p_pp_fp __spl_fp_PyObject_GenericGetAttr;
 
 #if PY_MAJOR_VERSION == 3
   static __splpy_mc2_fp __spl_fp_PyModule_Create2;
@@ -229,6 +298,12 @@ extern "C" {
   static PyObject * __spl_fi_PyImport_Import(PyObject *name) {
      return __spl_fp_PyImport_Import(name);
   }
+  static int __spl_fi_PyType_Ready(PyTypeObject *type) {
+     return __spl_fp_PyType_Ready(type);
+  }
+  static PyObject * __spl_fi_PyObject_GenericGetAttr(PyObject *o, PyObject *name) {
+     return __spl_fp_PyObject_GenericGetAttr(o, name);
+  }
 
 #if PY_MAJOR_VERSION == 3
   static PyObject * __spl_fi_PyModule_Create2(PyModuleDef *module, int apivers) {
@@ -251,6 +326,8 @@ extern "C" {
 #pragma weak PyObject_CallObject = __spl_fi_PyObject_CallObject
 #pragma weak PyCallable_Check = __spl_fi_PyCallable_Check
 #pragma weak PyImport_Import = __spl_fi_PyImport_Import
+#pragma weak PyType_Ready = __spl_fi_PyType_Ready
+#pragma weak PyObject_GenericGetAttr = __spl_fi_PyObject_GenericGetAttr
 
 #if PY_MAJOR_VERSION == 3
 #pragma weak PyModule_Create2 = __spl_fi_PyModule_Create2
@@ -266,21 +343,36 @@ extern "C" {
  */
 
 typedef int (*__splpy_dn_fp)(PyObject *, Py_ssize_t *, PyObject **, PyObject **);
+typedef PyObject * (*__splpy_bafsas_fp)(const char *, Py_ssize_t);
+typedef int (*__splpy_ogb_fp)(PyObject *, Py_buffer *, int);
+typedef void (*__splpy_br_fp)(Py_buffer *);
+#if PY_MAJOR_VERSION == 3
+typedef Py_hash_t (*__splpy_oh_fp)(PyObject *);
+#else
+typedef long (*__splpy_oh_fp)(PyObject *);
+#endif
 
 extern "C" {
   static __splpy_p_s_fp __spl_fp_PyTuple_New;
   static __splpy_p_p_fp __spl_fp_PyIter_Next;
   static __splpy_v_p_fp __spl_fp_PyDict_New;
+  static __splpy_p_s_fp __spl_fp__PyDict_NewPresized;
   static __splpy_s_p_fp __spl_fp_PyDict_Size;
   static __splpy_i_ppp_fp __spl_fp_PyDict_SetItem;
   static __splpy_p_pp_fp __spl_fp_PyDict_GetItem;
   static __splpy_dn_fp __spl_fp_PyDict_Next;
   static __splpy_p_s_fp __spl_fp_PyList_New;
   static __splpy_s_p_fp __spl_fp_PyList_Size;
+  static __splpy_i_pp_fp __spl_fp_PyList_Append;
   static __splpy_p_p_fp __spl_fp_PySet_New;
   static __splpy_s_p_fp __spl_fp_PySet_Size;
   static __splpy_i_pp_fp __spl_fp_PySet_Add;
   static __splpy_p_p_fp __spl_fp_PyObject_GetIter;
+  static __splpy_s_p_fp __spl_fp_PyObject_Size;
+  static __splpy_bafsas_fp __spl_fp_PyByteArray_FromStringAndSize;
+  static __splpy_ogb_fp __spl_fp_PyObject_GetBuffer;
+  static __splpy_br_fp __spl_fp_PyBuffer_Release;
+  static __splpy_oh_fp __spl_fp_PyObject_Hash;
 
   static PyObject * __spl_fi_PyTuple_New(Py_ssize_t size) {
      return __spl_fp_PyTuple_New(size);
@@ -291,6 +383,9 @@ extern "C" {
   static PyObject * __spl_fi_PyDict_New() {
      return __spl_fp_PyDict_New();
   }
+  static PyObject * __spl_fi__PyDict_NewPresized(Py_ssize_t minused) {
+     return __spl_fp__PyDict_NewPresized(minused);
+  }
   static Py_ssize_t __spl_fi_PyDict_Size(PyObject *d) {
      return __spl_fp_PyDict_Size(d);
   }
@@ -309,6 +404,9 @@ extern "C" {
   static Py_ssize_t __spl_fi_PyList_Size(PyObject *l) {
      return __spl_fp_PyList_Size(l);
   }
+  static int __spl_fi_PyList_Append(PyObject *l, PyObject *v) {
+     return __spl_fp_PyList_Append(l, v);
+  }
   static PyObject * __spl_fi_PySet_New(PyObject *o) {
      return __spl_fp_PySet_New(o);
   }
@@ -321,20 +419,46 @@ extern "C" {
   static PyObject * __spl_fi_PyObject_GetIter(PyObject *o) {
      return __spl_fp_PyObject_GetIter(o);
   }
+  static Py_ssize_t __spl_fi_PyObject_Size(PyObject *o) {
+     return __spl_fp_PyObject_Size(o);
+  }
+  static PyObject * __spl_fi_PyByteArray_FromStringAndSize(const char *v, Py_ssize_t len) {
+     return __spl_fp_PyByteArray_FromStringAndSize(v, len);
+  }
+  static int __spl_fi_PyObject_GetBuffer(PyObject *o, Py_buffer *view, int flags) {
+     return __spl_fp_PyObject_GetBuffer(o, view, flags);
+  }
+  static void __spl_fi_PyBuffer_Release(Py_buffer *view) {
+     __spl_fp_PyBuffer_Release(view);
+  }
+#if PY_MAJOR_VERSION == 3
+  static Py_hash_t __spl_fi_PyObject_Hash(PyObject *o) {
+#else
+  static long __spl_fi_PyObject_Hash(PyObject *o) {
+#endif
+     return __spl_fp_PyObject_Hash(o);
+  }
 }
 #pragma weak PyTuple_New = __spl_fi_PyTuple_New
 #pragma weak PyIter_Next = __spl_fi_PyIter_Next
 #pragma weak PyDict_New = __spl_fi_PyDict_New
+#pragma weak _PyDict_NewPresized = __spl_fi__PyDict_NewPresized
 #pragma weak PyDict_Size = __spl_fi_PyDict_Size
 #pragma weak PyDict_SetItem = __spl_fi_PyDict_SetItem
 #pragma weak PyDict_GetItem = __spl_fi_PyDict_GetItem
 #pragma weak PyDict_Next = __spl_fi_PyDict_Next
 #pragma weak PyList_New = __spl_fi_PyList_New
 #pragma weak PyList_Size = __spl_fi_PyList_Size
+#pragma weak PyList_Append = __spl_fi_PyList_Append
 #pragma weak PySet_New = __spl_fi_PySet_New
 #pragma weak PySet_Size = __spl_fi_PySet_Size
 #pragma weak PySet_Add = __spl_fi_PySet_Add
 #pragma weak PyObject_GetIter = __spl_fi_PyObject_GetIter
+#pragma weak PyObject_Size = __spl_fi_PyObject_Size
+#pragma weak PyByteArray_FromStringAndSize = __spl_fi_PyByteArray_FromStringAndSize
+#pragma weak PyObject_GetBuffer = __spl_fi_PyObject_GetBuffer
+#pragma weak PyBuffer_Release = __spl_fi_PyBuffer_Release
+#pragma weak PyObject_Hash = __spl_fi_PyObject_Hash
 
 /*
  * Type conversion
@@ -422,6 +546,8 @@ extern "C" {
 typedef void (*__splpy_ef_fp)(PyObject **, PyObject **, PyObject **);
 typedef void (*__splpy_er_fp)(PyObject *, PyObject *, PyObject *);
 typedef PyObject * (*__splpy_eo_fp)(void);
+typedef void (*__splpy_ess_fp)(PyObject *, const char *);
+typedef void (*__splpy_eso_fp)(PyObject *, PyObject *);
 extern "C" {
   static __splpy_ef_fp __spl_fp_PyErr_Fetch;
   static __splpy_ef_fp __spl_fp_PyErr_NormalizeException;
@@ -429,6 +555,8 @@ extern "C" {
   static __splpy_eo_fp __spl_fp_PyErr_Occurred;
   static __splpy_v_v_fp __spl_fp_PyErr_Print;
   static __splpy_v_v_fp __spl_fp_PyErr_Clear;
+  static __splpy_ess_fp __spl_fp_PyErr_SetString;
+  static __splpy_eso_fp __spl_fp_PyErr_SetObject;
 
   static void __spl_fi_PyErr_Fetch(PyObject **t, PyObject **v, PyObject **tb) {
      __spl_fp_PyErr_Fetch(t,v,tb);
@@ -448,6 +576,12 @@ extern "C" {
   static void  __spl_fi_PyErr_Clear() {
      __spl_fp_PyErr_Clear();
   }
+  static void  __spl_fi_PyErr_SetString(PyObject *t, const char *msg) {
+     __spl_fp_PyErr_SetString(t, msg);
+  }
+  static void  __spl_fi_PyErr_SetObject(PyObject *t, PyObject *v) {
+     __spl_fp_PyErr_SetObject(t, v);
+  }
 }
 #pragma weak PyErr_Fetch = __spl_fi_PyErr_Fetch
 #pragma weak PyErr_NormalizeException = __spl_fi_PyErr_NormalizeException
@@ -455,6 +589,8 @@ extern "C" {
 #pragma weak PyErr_Occurred = __spl_fi_PyErr_Occurred
 #pragma weak PyErr_Print = __spl_fi_PyErr_Print
 #pragma weak PyErr_Clear = __spl_fi_PyErr_Clear
+#pragma weak PyErr_SetString = __spl_fi_PyErr_SetString
+#pragma weak PyErr_SetObject = __spl_fi_PyErr_SetObject
 
 
 #define __SPLFIX_EX(_CPPNAME, _NAME, _TYPE) \
@@ -483,26 +619,38 @@ class SplpySym {
      __SPLFIX(PyEval_SaveThread, __splpy_ts_v_fp);
      __SPLFIX(PyEval_RestoreThread, __splpy_v_ts_fp);
 
+     __SPLFIX(Py_NewInterpreter, __splpy_ts_v_fp);
+     __SPLFIX(Py_EndInterpreter, __splpy_v_ts_fp);
+     __SPLFIX(PyThreadState_Get, __splpy_ts_v_fp);
+     __SPLFIX(PyThreadState_Swap, __splpy_ts_ts_fp);
+     __SPLFIX(PyThreadState_New, __splpy_ts_is_fp);
+     __SPLFIX(PyThreadState_Clear, __splpy_v_ts_fp);
+     __SPLFIX(PyThreadState_Delete, __splpy_v_ts_fp);
+
      __SPLFIX(PyObject_Str, __splpy_p_p_fp);
 
 #if PY_MAJOR_VERSION == 3
      __SPLFIX(PyUnicode_DecodeUTF8, __splpy_udu_fp);
      __SPLFIX(PyUnicode_AsUTF8String, __splpy_uaus_fp);
      __SPLFIX(PyBytes_AsString, __splpy_c_p_fp);
+     __SPLFIX(PyBytes_FromStringAndSize, __splpy_bfsas_fp);
 #else
      __SPLFIX_EX(__spl_fp_PyUnicode_DecodeUTF8, "PyUnicodeUCS4_DecodeUTF8", __splpy_udu_fp);
      __SPLFIX_EX(__spl_fp_PyUnicode_AsUTF8String, "PyUnicodeUCS4_AsUTF8String", __splpy_uaus_fp);
      __SPLFIX_EX(__spl_fp_PyBytes_AsString, "PyString_AsString", __splpy_c_p_fp);
+     __SPLFIX_EX(__spl_fp_PyBytes_FromStringAndSize, "PyString_FromStringAndSize", __splpy_bfsas_fp);
 #endif
 
 #if PY_MAJOR_VERSION == 3
      __SPLFIX(PyUnicode_AsUTF8AndSize, __splpy_uauas_fp);
      __SPLFIX(PyMemoryView_FromMemory, __splpy_mvfm_fp);
+     __SPLFIX(PyUnicode_New, __splpy_un_fp);
+     __SPLFIX(PyUnicode_InternInPlace, __splpy_uiip_fp);
 #else
      __SPLFIX(PyString_AsStringAndSize, __splpy_sasas_fp);
+#endif
      __SPLFIX(PyMemoryView_FromBuffer, __splpy_mvfb_fp);
      __SPLFIX(PyBuffer_FillInfo, __splpy_bfi_fp);
-#endif
 
      __SPLFIX(PyObject_GetAttrString, __splpy_ogas_fp);
      __SPLFIX(PyObject_HasAttrString, __splpy_ohas_fp);
@@ -511,6 +659,8 @@ class SplpySym {
      __SPLFIX(PyObject_CallObject, __splpy_p_pp_fp);
      __SPLFIX(PyCallable_Check, __splpy_i_p_fp);
      __SPLFIX(PyImport_Import, __splpy_p_p_fp);
+     __SPLFIX(PyType_Ready, __splpy_tr_fp);
+     __SPLFIX(PyObject_GenericGetAttr, __splpy_p_pp_fp);
 
 #if PY_MAJOR_VERSION == 3
      __SPLFIX(PyModule_Create2, __splpy_mc2_fp);
@@ -523,16 +673,23 @@ class SplpySym {
      __SPLFIX(PyTuple_New, __splpy_p_s_fp);
      __SPLFIX(PyIter_Next, __splpy_p_p_fp);
      __SPLFIX(PyDict_New, __splpy_v_p_fp);
+     __SPLFIX(_PyDict_NewPresized, __splpy_p_s_fp);
      __SPLFIX(PyDict_Size, __splpy_s_p_fp);
      __SPLFIX(PyDict_SetItem, __splpy_i_ppp_fp);
      __SPLFIX(PyDict_GetItem, __splpy_p_pp_fp);
      __SPLFIX(PyDict_Next, __splpy_dn_fp);
      __SPLFIX(PyList_New, __splpy_p_s_fp);
      __SPLFIX(PyList_Size, __splpy_s_p_fp);
+     __SPLFIX(PyList_Append, __splpy_i_pp_fp);
      __SPLFIX(PySet_New, __splpy_p_p_fp);
      __SPLFIX(PySet_Size, __splpy_s_p_fp);
      __SPLFIX(PySet_Add, __splpy_i_pp_fp);
      __SPLFIX(PyObject_GetIter, __splpy_p_p_fp);
+     __SPLFIX(PyObject_Size, __splpy_s_p_fp);
+     __SPLFIX(PyByteArray_FromStringAndSize, __splpy_bafsas_fp);
+     __SPLFIX(PyObject_GetBuffer, __splpy_ogb_fp);
+     __SPLFIX(PyBuffer_Release, __splpy_br_fp);
+     __SPLFIX(PyObject_Hash, __splpy_oh_fp);
 
      __SPLFIX(PyObject_IsTrue, __splpy_i_p_fp);
      __SPLFIX(PyLong_AsLong, __splpy_l_p_fp);
@@ -554,6 +711,8 @@ class SplpySym {
      __SPLFIX(PyErr_Occurred, __splpy_eo_fp);
      __SPLFIX(PyErr_Print, __splpy_v_v_fp);
      __SPLFIX(PyErr_Clear, __splpy_v_v_fp);
+     __SPLFIX(PyErr_SetString, __splpy_ess_fp);
+     __SPLFIX(PyErr_SetObject, __splpy_eso_fp);
    }
 };
 
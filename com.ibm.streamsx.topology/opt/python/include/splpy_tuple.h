@@ -16,7 +16,13 @@
 #ifndef __SPL__SPLPY_TUPLE_H
 #define __SPL__SPLPY_TUPLE_H
 
+#include <time.h>
+#include <vector>
+
 #include "splpy_general.h"
+#include "splpy_shm.h"
+#include "splpy_codec.h"
+#include "splpy_json.h"
 
 /*
  * Submit a tuple while holding the GIL.
@@ -24,11 +30,16 @@
  * using Py_UNBLOCK_THREADS and always retaken
  * after the submit using Py_BLOCK_THREADS
  * (even on exception).
+ * Downstream operators called by the submit
+ * do not execute in this operator's interpreter.
  */
 #define STREAMSX_TUPLE_SUBMIT_ALLOW_THREADS(otuple, port) \
   { PyThreadState *_save; \
+    streamsx::topology::SplpyGILMetrics::Released _released; \
+    streamsx::topology::SplpyStageMetrics::Submit _submitting; \
     Py_UNBLOCK_THREADS \
     try { \
+      streamsx::topology::SplpyInterpreter::Scope _unbound(NULL); \
       submit(otuple, port); \
       Py_BLOCK_THREADS \
     } catch (...) { \
@@ -37,6 +48,30 @@
     } \
   }
 
+/*
+ * Submit a vector of tuples while holding the GIL,
+ * releasing the GIL once for all the submits as
+ * STREAMSX_TUPLE_SUBMIT_ALLOW_THREADS does.
+ * The vector is cleared.
+ */
+#define STREAMSX_TUPLES_SUBMIT_ALLOW_THREADS(otuples, port) \
+  { PyThreadState *_save; \
+    streamsx::topology::SplpyGILMetrics::Released _released; \
+    streamsx::topology::SplpyStageMetrics::Submit _submitting; \
+    Py_UNBLOCK_THREADS \
+    try { \
+      streamsx::topology::SplpyInterpreter::Scope _unbound(NULL); \
+      for (size_t _i = 0; _i < otuples.size(); _i++) \
+          submit(otuples[_i], port); \
+      Py_BLOCK_THREADS \
+    } catch (...) { \
+      Py_BLOCK_THREADS \
+      otuples.clear(); \
+      throw; \
+    } \
+    otuples.clear(); \
+  }
+
 
 /**
  * Structure representing a SPL tuple containing a PyObject * pointer.
@@ -46,6 +81,12 @@
 // format for Python 2 is ASCII with no special header.
 #define STREAMSX_TPP_PTR ((unsigned char) 0x8F)
 #define STREAMSX_TPP_EMPTY ((unsigned char) 0x85)
+// Pickle protocol 5 value with out-of-band buffers laid out
+// after the pickled header, followed by a version byte, see
+// _pickle_dumps in streamsx.topology.runtime.
+#define STREAMSX_TPP_PICKLE5 ((unsigned char) 0x86)
+// STREAMSX_TPP_SHM (0x8E) is defined in splpy_shm.h
+// STREAMSX_TPP_CODEC (0x87) is defined in splpy_codec.h
 struct __SPLTuplePyPtr {
     unsigned char fmt;
     PyObject * pyptr;
@@ -54,14 +95,73 @@ struct __SPLTuplePyPtr {
 namespace streamsx {
   namespace topology {
 
+  /**
+   * Policy for submitting a list of Python values as tuples.
+   * Values are converted to tuples holding the GIL and the
+   * converted tuples are submitted releasing the GIL once
+   * (STREAMSX_TUPLES_SUBMIT_ALLOW_THREADS), rather than
+   * once per tuple.
+   *
+   * So that other threads are not starved of the GIL the
+   * converted tuples are submitted once the GIL has been held
+   * for conversion for longer than HOLD_NS (5ms, the default
+   * interval Python switches threads at), or MAX_TUPLES tuples
+   * have been converted. Thus the number of tuples
+   * submitted per release adapts to the cost of conversion.
+   */
+  class SplpySubmitList {
+    public:
+      static const size_t MAX_TUPLES = 1024;
+      static const size_t CHECK_TUPLES = 16;
+      static const long HOLD_NS = 5000000;
+
+      SplpySubmitList() : count_(0) {
+          start();
+      }
+
+      /**
+       * Called after converting a tuple, returns true
+       * when the converted tuples should be submitted.
+       */
+      bool added() {
+          if (++count_ >= MAX_TUPLES)
+              return true;
+          if (count_ % CHECK_TUPLES != 0)
+              return false;
+          struct timespec now;
+          clock_gettime(CLOCK_MONOTONIC, &now);
+          return (now.tv_sec - start_.tv_sec) * 1000000000L
+               + (now.tv_nsec - start_.tv_nsec) >= HOLD_NS;
+      }
+
+      /**
+       * Called after submitting the converted tuples.
+       */
+      void submitted() {
+          count_ = 0;
+          start();
+      }
+
+    private:
+      void start() {
+          clock_gettime(CLOCK_MONOTONIC, &start_);
+      }
+
+      size_t count_;
+      struct timespec start_;
+  };
+
   /**
    * Call a Python function passing in the SPL tuple as 
    * the single element of a Python tuple.
    * Steals the reference to value.
+   * Marks the stages of the calling operator's current sample.
    */
   inline PyObject * pyCallTupleFunc(PyObject *function, PyObject *pyTuple) {
 
+      SplpyStageMetrics::mark(SplpyStageMetrics::TO_PYTHON);
       PyObject * pyReturnVar = PyObject_CallObject(function, pyTuple);
+      SplpyStageMetrics::mark(SplpyStageMetrics::CALL);
       Py_DECREF(pyTuple);
 
       return pyReturnVar;
@@ -78,7 +178,7 @@ namespace streamsx {
    *
    *  CommonSchema.Python (pickle): SPL::blob & representing the single SPL attribute '__spl_po'
    *  CommonSchema.String (string): SPL::rstring & representing the single SPL attribute 'string'
-   *  CommonSchema.Json (json): SPL::rstring & representing the single SPL attribute 'jsonString'
+   *  CommonSchema.Json (json): SplpyJSON & representing the single SPL attribute 'jsonString'
    *  SPL Schema (dict):  PyObject * that is a dict object with all attributes of the SPL schema
    *  SPL Schema (tuple):  PyObject * that is a tuple object with all attributes of the SPL schema in order
    *
@@ -122,7 +222,7 @@ namespace streamsx {
           PyTuple_SET_ITEM(pyTuple, 0, value);
       }
       // Anything ASCII is also Pickle (Python 2 default format)
-      else if (fmt <= STREAMSX_TPP_PICKLE) {
+      else if (fmt <= STREAMSX_TPP_PICKLE || fmt == STREAMSX_TPP_PICKLE5) {
           PyObject * value = pySplValueToPyObject(pyo);
 
           pyTuple = PyTuple_New(2);
@@ -135,6 +235,24 @@ namespace streamsx {
           Py_INCREF(value);
           PyTuple_SET_ITEM(pyTuple, 1, value);
       }
+      else if (fmt == STREAMSX_TPP_SHM) {
+          // Pickled value in shared memory, released once
+          // the function has depickled it.
+          SplpyShmRef ref(pyo);
+          PyObject * value = ref.view();
+
+          pyTuple = PyTuple_New(2);
+          PyTuple_SET_ITEM(pyTuple, 0, value);
+          Py_INCREF(value);
+          PyTuple_SET_ITEM(pyTuple, 1, value);
+
+          return pyCallTupleFunc(function, pyTuple);
+      }
+      else if (fmt == STREAMSX_TPP_CODEC) {
+          // Decoded value is passed as an object.
+          pyTuple = PyTuple_New(1);
+          PyTuple_SET_ITEM(pyTuple, 0, SplpyCodec::decode(pyo));
+      }
       else {
           throw SPL::SPLRuntimeDeserializationException("pySplProcessTuple", "Invalid blob");
       }
@@ -151,6 +269,17 @@ namespace streamsx {
       return pyCallTupleFunc(function, pyTuple);
   }
 
+  /**
+   * The deserialized JSON object is passed to the function.
+   */
+  inline PyObject * pySplProcessTuple(PyObject * function, const SplpyJSON & pyj) {
+      PyObject * value = pyj.object();
+      PyObject * pyTuple = PyTuple_New(1);
+      PyTuple_SET_ITEM(pyTuple, 0, value);
+
+      return pyCallTupleFunc(function, pyTuple);
+  }
+
   inline PyObject * pySplProcessTuple(PyObject * function, PyObject * pyv) {
 
       PyObject * pyTuple = PyTuple_New(1);
@@ -158,6 +287,84 @@ namespace streamsx {
 
       return pyCallTupleFunc(function, pyTuple);
   }
+
+  /**
+   * Return the arguments pySplProcessTuple would pass to
+   * the function for a value, as a Python tuple, for use
+   * when the function is called for a batch of SPL tuples
+   * (see SplpyBatch).
+   *
+   * The arguments outlive the SPL tuple so a pickled value
+   * is copied into a bytes object rather than being a
+   * memory view onto the tuple's blob.
+   */
+  inline PyObject * pySplBatchArgs(const SPL::blob & pyo) {
+      unsigned char const *data = pyo.getData();
+      unsigned char fmt = *data;
+
+      PyObject *pyTuple;
+      if (fmt == STREAMSX_TPP_PTR) {
+          __SPLTuplePyPtr *stp = (__SPLTuplePyPtr *)(data);
+          PyObject * value = stp->pyptr;
+
+          pyTuple = PyTuple_New(1);
+          PyTuple_SET_ITEM(pyTuple, 0, value);
+      }
+      else if (fmt <= STREAMSX_TPP_PICKLE || fmt == STREAMSX_TPP_PICKLE5) {
+          PyObject * value = PyBytes_FromStringAndSize(
+                (const char *) data, pyo.getSize());
+          if (value == NULL)
+              throw SplpyExceptionInfo::pythonError("batch");
+
+          pyTuple = PyTuple_New(2);
+          PyTuple_SET_ITEM(pyTuple, 0, value);
+          Py_INCREF(value);
+          PyTuple_SET_ITEM(pyTuple, 1, value);
+      }
+      else if (fmt == STREAMSX_TPP_SHM) {
+          SplpyShmRef ref(pyo);
+          PyObject * value = PyBytes_FromStringAndSize(
+                (const char *) ref.data(), ref.size());
+          if (value == NULL)
+              throw SplpyExceptionInfo::pythonError("batch");
+
+          pyTuple = PyTuple_New(2);
+          PyTuple_SET_ITEM(pyTuple, 0, value);
+          Py_INCREF(value);
+          PyTuple_SET_ITEM(pyTuple, 1, value);
+      }
+      else if (fmt == STREAMSX_TPP_CODEC) {
+          pyTuple = PyTuple_New(1);
+          PyTuple_SET_ITEM(pyTuple, 0, SplpyCodec::decode(pyo));
+      }
+      else {
+          throw SPL::SPLRuntimeDeserializationException("pySplBatchArgs", "Invalid blob");
+      }
+      return pyTuple;
+  }
+
+  inline PyObject * pySplBatchArgs(const SPL::rstring & pys) {
+      PyObject * pyTuple = PyTuple_New(1);
+      PyTuple_SET_ITEM(pyTuple, 0, pySplValueToPyObject(pys));
+      return pyTuple;
+  }
+
+  inline PyObject * pySplBatchArgs(const SplpyJSON & pyj) {
+      PyObject * value = pyj.object();
+      PyObject * pyTuple = PyTuple_New(1);
+      PyTuple_SET_ITEM(pyTuple, 0, value);
+      return pyTuple;
+  }
+
+  /**
+   * Steals the reference to pyv.
+   */
+  inline PyObject * pySplBatchArgs(PyObject * pyv) {
+      PyObject * pyTuple = PyTuple_New(1);
+      PyTuple_SET_ITEM(pyTuple, 0, pyv);
+      return pyTuple;
+  }
+
     /**
      * Call a Python function passing in the SPL tuple as 
      * the single element of a Python tuple.
@@ -189,6 +396,19 @@ namespace streamsx {
 
        retSplVal.setData((unsigned char const *) &stpp, sizeof(__SPLTuplePyPtr));
     }
+
+    /**
+     * Release the references held by a blob set by pyTupleByRef
+     * with the same occ for a tuple that is not submitted.
+     * Caller must hold the GIL.
+     */
+    inline void pyTupleByRefRelease(const SPL::blob & splVal, int32_t occ) {
+       if (splVal.getSize() != sizeof(__SPLTuplePyPtr) || *splVal.getData() != STREAMSX_TPP_PTR)
+           return;
+       PyObject * value = ((const __SPLTuplePyPtr *) splVal.getData())->pyptr;
+       for (int i = 0; i < occ; i++)
+           Py_DECREF(value);
+    }
 }
 }
 #endif
@@ -0,0 +1,467 @@
+/*
+# Licensed Materials - Property of IBM
+# Copyright IBM Corp. 2018
+*/
+
+/*
+ * Internal header file supporting Python
+ * for com.ibm.streamsx.topology.
+ *
+ * This is not part of any public api for
+ * the toolkit or toolkit with decorated
+ * SPL Python operators.
+ *
+ * Functionality related to passing an SPL tuple
+ * into Python as a view whose attributes are
+ * converted to Python objects on access.
+ */
+
+#ifndef __SPL__SPLPY_VIEW_H
+#define __SPL__SPLPY_VIEW_H
+
+#include <string.h>
+#include <stddef.h>
+
+#include "splpy_general.h"
+
+// Py_REFCNT is not an lvalue from Python 3.10.
+#ifndef Py_SET_REFCNT
+#define Py_SET_REFCNT(o, n) (Py_REFCNT(o) = (n))
+#endif
+
+namespace streamsx {
+  namespace topology {
+
+/**
+ * Converts the attribute at index idx of an SPL tuple
+ * to a Python object, returning a new reference.
+ * Generated for an input port's schema by the operator.
+ */
+typedef PyObject * (*SplpyViewConverter)(SPL::Tuple const & tuple, uint32_t idx);
+
+/**
+ * Python object for a view of an SPL tuple.
+ *
+ * The view holds a pointer to the SPL tuple being
+ * processed and converts an attribute to a Python
+ * object when it is first accessed, caching the value.
+ *
+ * The SPL tuple is only valid during the operator's
+ * process method, so the view is released through
+ * SplpyTupleViewRelease. If the view has been retained by
+ * Python then any attribute not yet accessed is converted
+ * at that point, so that the view remains usable.
+ */
+struct SplpyTupleViewObject {
+    PyObject_VAR_HEAD
+
+    // Tuple being viewed, NULL once released.
+    SPL::Tuple const * tuple;
+    SplpyViewConverter convert;
+
+    // Schema (names, index) shared by views for a port.
+    PyObject * schema;
+
+    // Converted values, NULL if not yet accessed.
+    PyObject * values[1];
+};
+
+/**
+ * View of an SPL tuple presented to Python as
+ * a read-only mapping of attribute name to value.
+ *
+ * Values are accessed by attribute name (view['id']),
+ * by attribute position (view[0]) or as a Python
+ * attribute (view.id) when the name is not a method
+ * of the view. Iteration is over the attribute names
+ * and keys(), values(), items() and get() match dict.
+ */
+class SplpyTupleView {
+  public:
+    /**
+     * Create the schema object shared by views of tuples
+     * for a port from the port's attribute names,
+     * see Splpy::pyAttributeNames. Steals names.
+     *
+     * Caller must hold the GIL.
+     */
+    static PyObject * schema(PyObject * names) {
+        type();
+
+        const Py_ssize_t n = PyTuple_GET_SIZE(names);
+        PyObject * index = _PyDict_NewPresized(n);
+        for (Py_ssize_t i = 0; i < n; i++) {
+            PyObject * pi = PyLong_FromLong(i);
+            PyDict_SetItem(index, PyTuple_GET_ITEM(names, i), pi);
+            Py_DECREF(pi);
+        }
+
+        PyObject * schema = PyTuple_New(2);
+        PyTuple_SET_ITEM(schema, 0, names);
+        PyTuple_SET_ITEM(schema, 1, index);
+        return schema;
+    }
+
+    /**
+     * Create a view of tuple using convert for attribute values.
+     * Returns a new reference.
+     *
+     * Caller must hold the GIL.
+     */
+    static PyObject * create(PyObject * schema, SPL::Tuple const & tuple,
+           SplpyViewConverter convert) {
+        PyTypeObject * vt = type();
+        PyObject * view = vt->tp_alloc(vt, PyTuple_GET_SIZE(names(schema)));
+        if (view == NULL)
+            throw SplpyGeneral::pythonException("view");
+
+        SplpyTupleViewObject * tv = (SplpyTupleViewObject *) view;
+        tv->tuple = &tuple;
+        tv->convert = convert;
+        Py_INCREF(schema);
+        tv->schema = schema;
+        return view;
+    }
+
+    /**
+     * Release a view, stealing the reference, once the
+     * SPL tuple is no longer valid. If Python holds a
+     * reference to the view all remaining attributes
+     * are converted.
+     *
+     * Caller must hold the GIL.
+     */
+    static void release(PyObject * view) {
+        SplpyTupleViewObject * tv = (SplpyTupleViewObject *) view;
+        if (Py_REFCNT(view) > 1) {
+            for (Py_ssize_t i = 0; i < Py_SIZE(view); i++) {
+                PyObject * v = value(tv, i);
+                if (v == NULL)
+                    PyErr_Clear();
+                Py_XDECREF(v);
+            }
+        }
+        tv->tuple = NULL;
+        Py_DECREF(view);
+    }
+
+  private:
+    static PyObject * names(PyObject * schema) {
+        return PyTuple_GET_ITEM(schema, 0);
+    }
+    static PyObject * index(PyObject * schema) {
+        return PyTuple_GET_ITEM(schema, 1);
+    }
+
+    /**
+     * Value of attribute i, converting it on first access.
+     * Returns a new reference or NULL with an error set.
+     */
+    static PyObject * value(SplpyTupleViewObject * tv, Py_ssize_t i) {
+        PyObject * v = tv->values[i];
+        if (v == NULL) {
+            if (tv->tuple == NULL) {
+                PyErr_SetString(exception("ValueError"),
+                    "SPL tuple is no longer valid for view");
+                return NULL;
+            }
+            try {
+                v = tv->convert(*(tv->tuple), (uint32_t) i);
+            } catch (...) {
+                v = NULL;
+            }
+            if (v == NULL) {
+                if (!PyErr_Occurred())
+                    PyErr_SetString(exception("ValueError"),
+                       "Conversion of SPL attribute failed");
+                return NULL;
+            }
+            tv->values[i] = v;
+        }
+        Py_INCREF(v);
+        return v;
+    }
+
+    /**
+     * Index of attribute key, either its name or position.
+     * Returns -1 with an error set if key is not an attribute.
+     * As with a dict a bool key is not a position.
+     */
+    static Py_ssize_t indexOf(SplpyTupleViewObject * tv, PyObject * key) {
+#if PY_MAJOR_VERSION == 3
+        if (PyLong_Check(key) && !isBool(key)) {
+#else
+        if ((PyInt_Check(key) || PyLong_Check(key)) && !isBool(key)) {
+#endif
+            Py_ssize_t i = PyLong_AsLong(key);
+            if (i == -1 && PyErr_Occurred())
+                return -1;
+            if (i < 0)
+                i += Py_SIZE(tv);
+            if (i >= 0 && i < Py_SIZE(tv))
+                return i;
+            PyErr_SetString(exception("IndexError"), "view index out of range");
+            return -1;
+        }
+        PyObject * pi = PyDict_GetItem(index(tv->schema), key);
+        if (pi == NULL) {
+            PyErr_SetObject(exception("KeyError"), key);
+            return -1;
+        }
+        return PyLong_AsLong(pi);
+    }
+
+    /**
+     * List of the results of fn for each attribute.
+     */
+    static PyObject * list(SplpyTupleViewObject * tv,
+           PyObject * (*fn)(SplpyTupleViewObject *, Py_ssize_t)) {
+        PyObject * l = PyList_New(Py_SIZE(tv));
+        if (l == NULL)
+            return NULL;
+        for (Py_ssize_t i = 0; i < Py_SIZE(tv); i++) {
+            PyObject * e = fn(tv, i);
+            if (e == NULL) {
+                Py_DECREF(l);
+                return NULL;
+            }
+            PyList_SET_ITEM(l, i, e);
+        }
+        return l;
+    }
+    static PyObject * key(SplpyTupleViewObject * tv, Py_ssize_t i) {
+        PyObject * k = PyTuple_GET_ITEM(names(tv->schema), i);
+        Py_INCREF(k);
+        return k;
+    }
+    static PyObject * item(SplpyTupleViewObject * tv, Py_ssize_t i) {
+        PyObject * v = value(tv, i);
+        if (v == NULL)
+            return NULL;
+        PyObject * kv = PyTuple_New(2);
+        PyTuple_SET_ITEM(kv, 0, key(tv, i));
+        PyTuple_SET_ITEM(kv, 1, v);
+        return kv;
+    }
+
+    /**
+     * dict containing all the attributes.
+     */
+    static PyObject * asdict(SplpyTupleViewObject * tv) {
+        PyObject * d = _PyDict_NewPresized(Py_SIZE(tv));
+        if (d == NULL)
+            return NULL;
+        for (Py_ssize_t i = 0; i < Py_SIZE(tv); i++) {
+            PyObject * v = value(tv, i);
+            if (v == NULL) {
+                Py_DECREF(d);
+                return NULL;
+            }
+            PyDict_SetItem(d, PyTuple_GET_ITEM(names(tv->schema), i), v);
+            Py_DECREF(v);
+        }
+        return d;
+    }
+
+    // Python type slots and methods
+
+    static void tp_dealloc(PyObject * self) {
+        SplpyTupleViewObject * tv = (SplpyTupleViewObject *) self;
+        for (Py_ssize_t i = 0; i < Py_SIZE(self); i++)
+            Py_XDECREF(tv->values[i]);
+        Py_XDECREF(tv->schema);
+        Py_TYPE(self)->tp_free(self);
+    }
+    static Py_ssize_t mp_length(PyObject * self) {
+        return Py_SIZE(self);
+    }
+    static PyObject * mp_subscript(PyObject * self, PyObject * key) {
+        SplpyTupleViewObject * tv = (SplpyTupleViewObject *) self;
+        Py_ssize_t i = indexOf(tv, key);
+        return i == -1 ? NULL : value(tv, i);
+    }
+    static int sq_contains(PyObject * self, PyObject * key) {
+        SplpyTupleViewObject * tv = (SplpyTupleViewObject *) self;
+        return PyDict_GetItem(index(tv->schema), key) != NULL;
+    }
+    static PyObject * tp_iter(PyObject * self) {
+        return PyObject_GetIter(names(((SplpyTupleViewObject *) self)->schema));
+    }
+    static PyObject * tp_getattro(PyObject * self, PyObject * name) {
+        PyObject * attr = PyObject_GenericGetAttr(self, name);
+        if (attr != NULL)
+            return attr;
+
+        SplpyTupleViewObject * tv = (SplpyTupleViewObject *) self;
+        PyObject * pi = PyDict_GetItem(index(tv->schema), name);
+        if (pi == NULL)
+            return NULL;
+        PyErr_Clear();
+        return value(tv, PyLong_AsLong(pi));
+    }
+    static PyObject * tp_str(PyObject * self) {
+        PyObject * d = asdict((SplpyTupleViewObject *) self);
+        if (d == NULL)
+            return NULL;
+        PyObject * s = PyObject_Str(d);
+        Py_DECREF(d);
+        return s;
+    }
+
+    static PyObject * m_keys(PyObject * self, PyObject *) {
+        return list((SplpyTupleViewObject *) self, key);
+    }
+    static PyObject * m_values(PyObject * self, PyObject *) {
+        return list((SplpyTupleViewObject *) self, value);
+    }
+    static PyObject * m_items(PyObject * self, PyObject *) {
+        return list((SplpyTupleViewObject *) self, item);
+    }
+    static PyObject * m_get(PyObject * self, PyObject * args) {
+        SplpyTupleViewObject * tv = (SplpyTupleViewObject *) self;
+        Py_ssize_t nargs = PyTuple_GET_SIZE(args);
+        if (nargs < 1 || nargs > 2) {
+            PyErr_SetString(exception("TypeError"), "get expected 1 or 2 arguments");
+            return NULL;
+        }
+        PyObject * pi = PyDict_GetItem(index(tv->schema), PyTuple_GET_ITEM(args, 0));
+        if (pi != NULL)
+            return value(tv, PyLong_AsLong(pi));
+
+        PyObject * dv = nargs == 2 ? PyTuple_GET_ITEM(args, 1) : NULL;
+        if (dv == NULL)
+            return SplpyGeneral::getNone(NULL);
+        Py_INCREF(dv);
+        return dv;
+    }
+    static PyObject * m_asdict(PyObject * self, PyObject *) {
+        return asdict((SplpyTupleViewObject *) self);
+    }
+    // Views pickle as a dict as the SPL tuple cannot be pickled.
+    static PyObject * m_reduce(PyObject * self, PyObject *) {
+        PyObject * d = asdict((SplpyTupleViewObject *) self);
+        if (d == NULL)
+            return NULL;
+        PyObject * args = PyTuple_New(1);
+        PyTuple_SET_ITEM(args, 0, d);
+        PyObject * rv = PyTuple_New(2);
+        Py_INCREF(Py_TYPE(d));
+        PyTuple_SET_ITEM(rv, 0, (PyObject *) Py_TYPE(d));
+        PyTuple_SET_ITEM(rv, 1, args);
+        return rv;
+    }
+
+    /**
+     * Built-in exception class by name, loaded when
+     * the type is created as the exception objects cannot
+     * be referenced directly by the operator shared library.
+     */
+    static bool isBool(PyObject * key) {
+        static PyTypeObject * bool_ = NULL;
+        if (bool_ == NULL) {
+            PyObject * v = PyBool_FromLong(1);
+            bool_ = Py_TYPE(v);
+            Py_DECREF(v);
+        }
+        return Py_TYPE(key) == bool_;
+    }
+    static PyObject * exception(const char * name) {
+        static PyObject * builtins = SplpyGeneral::importModule(
+#if PY_MAJOR_VERSION == 3
+            "builtins"
+#else
+            "__builtin__"
+#endif
+        );
+        PyObject * exc = PyObject_GetAttrString(builtins, name);
+        // Borrowed from the builtins module.
+        Py_DECREF(exc);
+        return exc;
+    }
+
+    /**
+     * The Python type for views, created on first use.
+     */
+    static PyTypeObject * type() {
+        static PyTypeObject * viewType = createType();
+        return viewType;
+    }
+
+    static PyTypeObject * createType() {
+        static PyMappingMethods mapping;
+        static PySequenceMethods sequence;
+        static PyMethodDef methods[] = {
+            {"keys", (PyCFunction) m_keys, METH_NOARGS, NULL},
+            {"values", (PyCFunction) m_values, METH_NOARGS, NULL},
+            {"items", (PyCFunction) m_items, METH_NOARGS, NULL},
+            {"get", (PyCFunction) m_get, METH_VARARGS, NULL},
+            {"_asdict", (PyCFunction) m_asdict, METH_NOARGS, NULL},
+            {"__reduce__", (PyCFunction) m_reduce, METH_NOARGS, NULL},
+            {NULL, NULL, 0, NULL}
+        };
+        static PyTypeObject vt;
+
+        memset(&mapping, 0, sizeof(mapping));
+        mapping.mp_length = mp_length;
+        mapping.mp_subscript = mp_subscript;
+
+        memset(&sequence, 0, sizeof(sequence));
+        sequence.sq_contains = sq_contains;
+
+        // Type of the type object is set by PyType_Ready.
+        memset(&vt, 0, sizeof(vt));
+        Py_SET_REFCNT(&vt, 1);
+        vt.tp_name = "streamsx.topology.TupleView";
+        vt.tp_basicsize = offsetof(SplpyTupleViewObject, values);
+        vt.tp_itemsize = sizeof(PyObject *);
+        vt.tp_flags = Py_TPFLAGS_DEFAULT;
+        vt.tp_doc = "Read-only view of an SPL tuple.";
+        vt.tp_dealloc = tp_dealloc;
+        vt.tp_as_mapping = &mapping;
+        vt.tp_as_sequence = &sequence;
+        vt.tp_iter = tp_iter;
+        vt.tp_getattro = tp_getattro;
+        vt.tp_repr = tp_str;
+        vt.tp_str = tp_str;
+        vt.tp_methods = methods;
+
+        if (PyType_Ready(&vt) != 0)
+            throw SplpyGeneral::pythonException("view");
+        return &vt;
+    }
+};
+
+/**
+ * RAII release of the view passed into Python for
+ * the tuple being processed. The view is created
+ * through create() holding the GIL and released
+ * once this goes out of scope at the end of process.
+ */
+class SplpyTupleViewRelease {
+  public:
+    SplpyTupleViewRelease() : view_(NULL) {
+    }
+    ~SplpyTupleViewRelease() {
+        if (view_ != NULL) {
+            SplpyGIL lock;
+            SplpyTupleView::release(view_);
+        }
+    }
+    /**
+     * Create the view, returning a new reference.
+     * Caller must hold the GIL.
+     */
+    PyObject * create(PyObject * schema, SPL::Tuple const & tuple,
+           SplpyViewConverter convert) {
+        PyObject * view = SplpyTupleView::create(schema, tuple, convert);
+        Py_INCREF(view);
+        view_ = view;
+        return view;
+    }
+  private:
+    PyObject * view_;
+};
+
+}}
+
+#endif
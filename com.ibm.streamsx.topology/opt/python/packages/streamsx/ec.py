@@ -91,6 +91,11 @@ context when Python code is running in a Streams application.
 Access is only supported when running:
  * Streams 4.2 or later
 
+Access is not supported in the worker processes of a stream
+with :py:meth:`~streamsx.topology.topology.Stream.set_workers`,
+such as job and PE information, custom metrics and application
+configuration. Submission parameters are available in a worker.
+
 This module may be used by Python functions or classes used
 in a `Topology` or decorated SPL operators.
 
@@ -141,6 +146,8 @@ def _check():
             _State._state = _State(False)
 
     if not _State._state._supported:
+        if _WORKER:
+            raise NotImplementedError("Access to the execution context is not supported in a Python worker process")
         raise NotImplementedError("Access to the execution context requires Streams 4.2 or later")
 
 def domain_id():
@@ -552,6 +559,9 @@ def _setup():
 
 _SUBMIT_PARAMS = dict()
 
+# True in a worker process of a functional operator.
+_WORKER = False
+
 # Called from C++ Python functional operators to make
 # submission parameters visible to Python callables.
 # Each name and value are strings.
@@ -8,6 +8,7 @@ import os
 import sys
 import pickle
 import logging
+import numbers
 from past.builtins import basestring
 
 import streamsx.ec as ec
@@ -26,6 +27,7 @@ dill.settings['recurse'] = True
 
 import base64
 import json
+import struct
 from pkgutil import extend_path
 import streamsx
 
@@ -33,6 +35,287 @@ import streamsx
 def _identity(tuple_):
     return tuple_
 
+# Invoke a wrapped callable for a batch of tuples.
+# batch is a list containing the arguments for each
+# tuple, as passed by the operator for a single tuple.
+# The return of each call is appended to rvs, starting
+# at the arguments at index len(rvs). If a call raises
+# an exception the operator determines the failing tuple
+# from len(rvs) and, if the exception is suppressed,
+# calls again to continue after the failing tuple.
+def _call_batch(callable_, batch, rvs):
+    for i in range(len(rvs), len(batch)):
+        rvs.append(callable_(*batch[i]))
+
+# Invoke a wrapped filter callable for a batch of tuples.
+# Appends 1 to the mask (a bytearray) for each tuple the
+# callable returns a true value for, otherwise 0, following
+# the same contract as _call_batch for exceptions.
+def _filter_batch(callable_, batch, mask):
+    if isinstance(getattr(callable_, '_callable', None), _VectorizedFilter):
+        callable_._callable._filter(callable_, batch, mask)
+        return
+    for i in range(len(mask), len(batch)):
+        mask.append(1 if callable_(*batch[i]) else 0)
+
+# Invoke the callable for a batch of tuples in the worker
+# processes of pool, with the same contract as _call_batch.
+def _call_workers(pool, batch, rvs):
+    pool.call(batch, len(rvs), rvs.append)
+
+# Invoke the filter callable for a batch of tuples in the worker
+# processes of pool, with the same contract as _filter_batch.
+def _filter_workers(pool, batch, mask):
+    pool.call(batch, len(mask), lambda rv : mask.append(1 if rv else 0))
+
+def _close_workers(pool):
+    pool.close()
+
+# Pool of worker Python processes that a functional operator
+# invokes its callable in for batches of tuples, allowing
+# a single operator to use multiple cores.
+#
+# Each worker executes _worker_main, loading and wrapping the
+# application callable as the operator does. Requests and responses
+# are pickled messages, each preceded by its length, over the
+# worker's stdin and stdout pipes. A batch is split into contiguous
+# chunks, one per worker, and the results are gathered in order.
+# The GIL is released while the operator waits for the workers.
+#
+# Exceptions raised by the callable in a worker are raised by
+# call() at the failing tuple, so that the operator can pass them
+# to the callable's __exit__ method and continue after the tuple
+# using the results already computed for the rest of the batch.
+#
+# A worker that exits while processing its chunk (e.g. the callable
+# calls os._exit or crashes the interpreter) is replaced by a new
+# worker that processes the chunk one tuple at a time. A tuple that
+# causes the new worker to exit raises RuntimeError at that tuple,
+# and that worker is replaced in turn.
+class _WorkerPool(object):
+    def __init__(self, count, module, name, callable_, wrapfn, attributes):
+        env = dict(os.environ)
+        env['PYTHONPATH'] = os.pathsep.join(p for p in sys.path if p)
+        self._setup = (module, name, callable_, wrapfn, attributes, dict(ec._SUBMIT_PARAMS))
+        self._env = env
+        self._cmd = [_python_executable(), '-c',
+            'import streamsx.topology.runtime as r; r._worker_main()']
+        self._name = module + '.' + name
+
+        self._workers = []
+        self._batch = None
+        try:
+            for _ in range(count):
+                self._workers.append(self._start())
+            for w in self._workers:
+                self._started(w)
+        except:
+            self.close()
+            raise
+        logging.getLogger('streamsx.runtime').info('Started %d Python worker processes for %s', count, self._name)
+
+    def _start(self):
+        import subprocess
+        w = subprocess.Popen(self._cmd, stdin=subprocess.PIPE,
+            stdout=subprocess.PIPE, env=self._env, close_fds=True)
+        _worker_write(w.stdin, self._setup)
+        return w
+
+    def _started(self, w):
+        response = _worker_read(w.stdout)
+        if response is None:
+            raise RuntimeError('Python worker process for ' + self._name + ' exited during setup with code ' + str(w.wait()))
+        if response[2]:
+            raise response[2][0]
+
+    def _worker(self, index):
+        """Worker at index, starting a new worker if it was replaced."""
+        w = self._workers[index]
+        if w is None:
+            w = self._start()
+            try:
+                self._started(w)
+            except:
+                self._exited(w)
+                raise
+            self._workers[index] = w
+        return w
+
+    def _replace(self, index):
+        """Replace the worker at index that has exited."""
+        w = self._workers[index]
+        self._workers[index] = None
+        self._exited(w)
+        logging.getLogger('streamsx.runtime').warning('Python worker process %d for %s exited with code %s, starting a new worker', w.pid, self._name, w.returncode)
+        self._worker(index)
+
+    def call(self, batch, start, append):
+        """Call the callable for each tuple in batch from
+        index start, passing each return in order to append.
+        """
+        if self._batch is not batch:
+            self._rvs = {}
+            self._errors = {}
+            chunk = max(1, -(-(len(batch) - start) // len(self._workers)))
+            sent = []
+            for first in range(start, len(batch), chunk):
+                self._request(len(sent), first, batch[first:first+chunk])
+                sent.append(first)
+            # All responses are read before any retry so that no
+            # worker is left with an unread response.
+            responses = [self._response(index) for index in range(len(sent))]
+            for index, first in enumerate(sent):
+                response = responses[index]
+                if response is None:
+                    response = self._retry(index, first, batch[first:first+chunk])
+                first, rvs, errors = response
+                for i, rv in enumerate(rvs):
+                    self._rvs[first + i] = rv
+                self._errors.update(errors)
+            self._batch = batch
+
+        for i in range(start, len(batch)):
+            if i in self._errors:
+                raise self._errors.pop(i)
+            append(self._rvs.pop(i))
+        self._batch = None
+
+    def _request(self, index, first, args):
+        w = self._worker(index)
+        try:
+            _worker_write(w.stdin, (first, args))
+        except EnvironmentError:
+            # Worker has exited, seen as no response
+            pass
+
+    def _response(self, index):
+        """Response from the worker at index, None if it exited."""
+        try:
+            return _worker_read(self._workers[index].stdout)
+        except EOFError:
+            return None
+
+    def _retry(self, index, first, args):
+        """Process args that the worker at index exited processing
+        one tuple at a time in its replacement."""
+        self._replace(index)
+        rvs = []
+        errors = {}
+        for i, a in enumerate(args):
+            self._request(index, first + i, [a])
+            response = self._response(index)
+            if response is None:
+                pid = self._workers[index].pid
+                self._replace(index)
+                rvs.append(None)
+                errors[first + i] = RuntimeError('Python worker process ' + str(pid) + ' for ' + self._name + ' exited processing the tuple')
+            else:
+                rvs.extend(response[1])
+                errors.update(response[2])
+        return first, rvs, errors
+
+    @staticmethod
+    def _exited(w):
+        for f in (w.stdin, w.stdout):
+            try:
+                f.close()
+            except EnvironmentError:
+                pass
+        w.wait()
+
+    def close(self):
+        """Shut down the workers, each calls __exit__ on its
+        instance of the callable and exits.
+        """
+        workers = [w for w in self._workers if w is not None]
+        self._workers = []
+        for w in workers:
+            try:
+                w.stdin.close()
+            except EnvironmentError:
+                pass
+        for w in workers:
+            w.stdout.close()
+            w.wait()
+
+# Python executable for worker processes. When Python is embedded
+# in a processing element sys.executable is not reliable, so the
+# executable of the installation that is loaded is used.
+def _python_executable():
+    for name in ('python%d.%d' % sys.version_info[:2], 'python%d' % sys.version_info[0]):
+        exe = os.path.join(sys.exec_prefix, 'bin', name)
+        if os.path.isfile(exe):
+            return exe
+    if sys.executable:
+        return sys.executable
+    raise RuntimeError('Python executable not found for worker processes: ' + sys.exec_prefix)
+
+def _worker_write(f, msg):
+    data = pickle.dumps(msg, pickle.HIGHEST_PROTOCOL)
+    f.write(struct.pack('<Q', len(data)))
+    f.write(data)
+    f.flush()
+
+def _worker_read(f):
+    header = f.read(8)
+    if not header:
+        return None
+    size = struct.unpack('<Q', header)[0] if len(header) == 8 else -1
+    data = f.read(size) if size >= 0 else b''
+    if len(data) != size:
+        raise EOFError('Incomplete message from Python worker process')
+    return pickle.loads(data)
+
+def _worker_exception(e):
+    try:
+        pickle.dumps(e, pickle.HIGHEST_PROTOCOL)
+        return e
+    except Exception:
+        import traceback
+        return RuntimeError(traceback.format_exc())
+
+# Main loop of a worker process of a _WorkerPool.
+def _worker_main():
+    # Messages use the original stdin and stdout, output
+    # from the application is written to stderr.
+    rf = os.fdopen(os.dup(0), 'rb')
+    wf = os.fdopen(os.dup(1), 'wb')
+    os.dup2(2, 1)
+    null = os.open(os.devnull, os.O_RDONLY)
+    os.dup2(null, 0)
+    os.close(null)
+
+    setup = _worker_read(rf)
+    if setup is None:
+        return
+    module, name, callable_, wrapfn, attributes, params = setup
+    try:
+        ec._WORKER = True
+        ec._SUBMIT_PARAMS.update(params)
+        import importlib
+        function = getattr(importlib.import_module(module), name)
+        callable_ = globals()[wrapfn](function if callable_ is None else callable_, attributes)
+        _worker_write(wf, (0, [], {}))
+    except Exception as e:
+        _worker_write(wf, (0, [], {0: _worker_exception(e)}))
+        return
+
+    while True:
+        request = _worker_read(rf)
+        if request is None:
+            break
+        first, batch = request
+        rvs = []
+        errors = {}
+        for i, args in enumerate(batch):
+            try:
+                rvs.append(callable_(*args))
+            except Exception as e:
+                rvs.append(None)
+                errors[first + i] = _worker_exception(e)
+        _worker_write(wf, (first, rvs, errors))
+    ec._shutdown_op(callable_)
+
 def __splpy_addDirToPath(dir_):
     if os.path.isdir(dir_):
         if dir_ not in sys.path:
@@ -54,6 +337,93 @@ def _json_force_object(v):
     if not isinstance(v, dict):
         v = {'payload': v}
     return v
+
+# Pickling of Python objects on streams.
+#
+# With pickle protocol 5 large buffers, such as
+# numpy arrays, are pickled out-of-band and laid out after the
+# pickled header instead of being copied into the pickle stream.
+# Values with out-of-band buffers are serialized as:
+#
+#  0x86 (STREAMSX_TPP_PICKLE5), version, 2 bytes reserved
+#  uint32 number of buffers
+#  uint64 length of pickled header
+#  uint64 length of each buffer
+#  pickled header
+#  each buffer, padded to start at a multiple of 16 bytes
+#  from the end of the pickled header
+#
+# Values without out-of-band buffers are a regular pickle.
+#
+# Protocol 5 is provided by the pickle module from Python 3.8
+# and by the pickle5 backport package with Python 3.6 and 3.7.
+# Python processing elements load libpython3.Xm.so, thus protocol 5
+# is used by the supported Python 3 runtimes when pickle5 is installed.
+_PICKLE5 = 0x86
+_PICKLE5_VERSION = 1
+# Smaller buffers are pickled in-band
+_PICKLE5_OOB_MIN = 1024
+
+if sys.version_info >= (3, 8):
+    _pickle5 = pickle
+elif sys.version_info >= (3, 5):
+    try:
+        import pickle5 as _pickle5
+    except ImportError:
+        _pickle5 = None
+else:
+    _pickle5 = None
+
+if _pickle5 is not None:
+    def _pickle_dumps(v):
+        raws = []
+        def _oob(b):
+            try:
+                raw = b.raw()
+            except BufferError:
+                return True
+            if raw.nbytes < _PICKLE5_OOB_MIN:
+                return True
+            raws.append(raw)
+        header = _pickle5.dumps(v, protocol=5, buffer_callback=_oob)
+        if not raws:
+            return header
+        n = len(raws)
+        parts = [struct.pack('<BBHI%dQ' % (n + 1), _PICKLE5, _PICKLE5_VERSION, 0, n,
+            len(header), *[raw.nbytes for raw in raws]), header]
+        offset = 0
+        for raw in raws:
+            pad = -offset % 16
+            if pad:
+                parts.append(b'\0' * pad)
+            parts.append(raw)
+            offset += pad + raw.nbytes
+        return b''.join(parts)
+
+    def _pickle_loads(pv):
+        if pv[0] != _PICKLE5:
+            return _pickle5.loads(pv)
+        if pv[1] != _PICKLE5_VERSION:
+            raise ValueError('Unsupported pickle format version: ' + str(pv[1]))
+        pv = memoryview(pv)
+        n = struct.unpack_from('<I', pv, 4)[0]
+        lens = struct.unpack_from('<%dQ' % (n + 1), pv, 8)
+        start = 8 + 8 * (n + 1)
+        header = pv[start:start+lens[0]]
+        # The tuple's memory is only valid during the call so the
+        # buffers are copied once into memory owned by the value and
+        # the reconstructed objects (e.g. numpy arrays) are views onto it.
+        data = memoryview(bytearray(pv[start+lens[0]:]))
+        buffers = []
+        offset = 0
+        for bl in lens[1:]:
+            offset += -offset % 16
+            buffers.append(data[offset:offset+bl])
+            offset += bl
+        return _pickle5.loads(header, buffers=buffers)
+else:
+    _pickle_dumps = pickle.dumps
+    _pickle_loads = pickle.loads
     
 # Get the callable from the value
 # passed into the SPL PyFunction operator.
@@ -106,29 +476,29 @@ class _FunctionalCallable(object):
 class _PickleInObjectOut(_FunctionalCallable):
     def __call__(self, tuple_, pm=None):
         if pm is not None:
-            tuple_ = pickle.loads(tuple_)
+            tuple_ = _pickle_loads(tuple_)
         return self._callable(tuple_)
 
 class _PickleInPickleOut(_FunctionalCallable):
     def __call__(self, tuple_, pm=None):
         if pm is not None:
-            tuple_ = pickle.loads(tuple_)
+            tuple_ = _pickle_loads(tuple_)
         rv =  self._callable(tuple_)
         if rv is None:
             return None
-        return pickle.dumps(rv)
+        return _pickle_dumps(rv)
 
 class _PickleInJSONOut(_FunctionalCallable):
     def __call__(self, tuple_, pm=None):
         if pm is not None:
-            tuple_ = pickle.loads(tuple_)
+            tuple_ = _pickle_loads(tuple_)
         rv =  self._callable(tuple_)
         return _json_object_out(rv)
 
 class _PickleInStringOut(_FunctionalCallable):
     def __call__(self, tuple_, pm=None):
         if pm is not None:
-            tuple_ = pickle.loads(tuple_)
+            tuple_ = _pickle_loads(tuple_)
         rv =  self._callable(tuple_)
         if rv is None:
             return None
@@ -137,7 +507,7 @@ class _PickleInStringOut(_FunctionalCallable):
 class _PickleInTupleOut(_FunctionalCallable):
     def __call__(self, tuple_, pm=None):
         if pm is not None:
-            tuple_ = pickle.loads(tuple_)
+            tuple_ = _pickle_loads(tuple_)
         return self._callable(tuple_)
 
 class _ObjectInTupleOut(_FunctionalCallable):
@@ -149,7 +519,7 @@ class _ObjectInPickleOut(_FunctionalCallable):
         rv =  self._callable(tuple_)
         if rv is None:
             return None
-        return pickle.dumps(rv)
+        return _pickle_dumps(rv)
 
 
 class _ObjectInStringOut(_FunctionalCallable):
@@ -176,7 +546,7 @@ class _JSONInPickleOut(_FunctionalCallable):
         rv =  self._callable(json.loads(tuple_))
         if rv is None:
             return None
-        return pickle.dumps(rv)
+        return _pickle_dumps(rv)
 
 
 class _JSONInStringOut(_FunctionalCallable):
@@ -288,7 +658,7 @@ class _IterableAnyOut(_FunctionalCallable):
 class _IterablePickleOut(_IterableAnyOut):
     def __init__(self, callable, attributes=None):
         super(_IterablePickleOut, self).__init__(callable, attributes)
-        self.pdfn = pickle.dumps
+        self.pdfn = _pickle_dumps
 
     def __call__(self):
         tuple_ = super(_IterablePickleOut, self).__call__()
@@ -319,7 +689,7 @@ class _ObjectIterator(object):
 # and pickle any returned value.
 class _PickleIterator(_ObjectIterator):
    def __next__(self):
-       return pickle.dumps(super(_PickleIterator, self).__next__())
+       return _pickle_dumps(super(_PickleIterator, self).__next__())
 
 # Return a function that depickles
 # the input tuple calls callable
@@ -350,14 +720,14 @@ class _ObjectInObjectIter(_FunctionalCallable):
 class _PickleInPickleIter(_ObjectInPickleIter):
     def __call__(self, tuple_, pm=None):
         if pm is not None:
-            tuple_ = pickle.loads(tuple_)
+            tuple_ = _pickle_loads(tuple_)
         return super(_PickleInPickleIter, self).__call__(tuple_)
 
 
 class _PickleInObjectIter(_ObjectInObjectIter):
     def __call__(self, tuple_, pm=None):
         if pm is not None:
-            tuple_ = pickle.loads(tuple_)
+            tuple_ = _pickle_loads(tuple_)
         return super(_PickleInObjectIter, self).__call__(tuple_)
 
 
@@ -384,6 +754,7 @@ object_in__object_out = _FunctionalCallable
 object_in__object_iter = _ObjectInObjectIter
 object_in__pickle_out = _ObjectInPickleOut
 object_in__pickle_iter = _ObjectInPickleIter
+object_in__string_out = _ObjectInStringOut
 object_in__json_out = _ObjectInJSONOut
 object_in__dict_out = _ObjectInTupleOut
 object_in = _FunctionalCallable
@@ -434,6 +805,15 @@ tuple_in__json_out = object_in__json_out
 tuple_in__dict_out = object_in__dict_out
 tuple_in = object_in
 
+view_in__object_out = object_in__object_out
+view_in__object_iter = object_in__object_iter
+view_in__pickle_out = object_in__pickle_out
+view_in__pickle_iter = object_in__pickle_iter
+view_in__string_out = object_in__object_out
+view_in__json_out = object_in__json_out
+view_in__dict_out = object_in__dict_out
+view_in = object_in
+
 # Get the named tuple class for a schema.
 # used by functional operators.
 def _get_namedtuple_cls(schema, name):
@@ -469,6 +849,105 @@ class _Callable(_WrappedInstance):
     def __call__(self, *args, **kwargs):
         return self._callable.__call__(*args, **kwargs)
 
+# Wraps an accumulator instance for Window.accumulate.
+# The Aggregate operator calls the accumulator's add and
+# remove methods directly as tuples are inserted into and
+# evicted from the window, and calls this when the window
+# is triggered to return the accumulator's result.
+class _Accumulator(_WrappedInstance):
+    def __call__(self, items=None):
+        return self._callable.result()
+
+# Return the add and remove methods of the accumulator
+# invoked through the operator's wrapped callable.
+def _accumulator_methods(wrapper):
+    acc = wrapper._callable._callable
+    return acc.add, acc.remove
+
+# Wraps the aggregation function of a window partitioned
+# by a key callable, see Window.partition. The Aggregate
+# operator obtains the partition of each tuple through
+# the function returned by _partition_key.
+class _PartitionedAggregate(_WrappedInstance):
+    def __init__(self, callable_, key):
+        super(_PartitionedAggregate, self).__init__(callable_)
+        self._key = key
+
+    def __call__(self, items):
+        return self._callable(items)
+
+# Wraps a vectorized filter predicate, see Stream.filter.
+# The operator's wrapped callable converts each tuple of a
+# batch to its Python value through __call__ and the predicate
+# is called once for the list of values of the batch.
+class _VectorizedFilter(_WrappedInstance):
+    def __call__(self, value):
+        return value
+
+    # Append the selection of the predicate for the batch to
+    # mask with the same contract as _filter_batch. A non-empty
+    # mask means an exception was suppressed for the batch, thus
+    # none of its remaining tuples are selected.
+    def _filter(self, wrapper, batch, mask):
+        if len(mask):
+            mask.extend(bytearray(len(batch) - len(mask)))
+            return
+        values = [wrapper(*args) for args in batch]
+        sel = self._callable(values)
+        try:
+            view = memoryview(sel)
+        except TypeError:
+            view = None
+        if view is not None and view.itemsize == 1:
+            # bytes, bytearray and numpy bool arrays are copied
+            # into the mask as is, a non-zero byte selects the tuple.
+            _check_selection(view, values)
+            try:
+                mask += view
+            except (BufferError, TypeError):
+                # Not contiguous.
+                mask += view.tobytes()
+            return
+        if view is not None:
+            sel = view.tolist()
+        sel = bytearray(1 if s else 0 for s in sel)
+        _check_selection(sel, values)
+        mask.extend(sel)
+
+def _check_selection(sel, values):
+    if len(sel) != len(values):
+        raise ValueError('Filter selection has ' + str(len(sel)) + ' entries for a batch of ' + str(len(values)) + ' tuples')
+
+# Return a function returning the partition of a value
+# invoked through the operator's wrapped callable.
+# Partitions are identified by a string representing
+# the key, see _partition_repr.
+def _partition_key(wrapper):
+    key = wrapper._callable._key
+    return lambda value : _partition_repr(key(value))
+
+# Return the string identifying the partition of key, keys
+# that compare equal have the same string. Keys are limited to
+# str, int and float values and tuples of those so that equal
+# keys are represented the same way, for example 1, 1.0 and True.
+def _partition_repr(key):
+    if isinstance(key, numbers.Integral):
+        return 'i%d' % key
+    if isinstance(key, float):
+        if key.is_integer():
+            return 'i%d' % int(key)
+        return 'f' + repr(key)
+    if isinstance(key, type(b'')) and sys.version_info.major == 2:
+        try:
+            key = key.decode('ascii')
+        except UnicodeDecodeError:
+            return 'b' + repr(key)
+    if isinstance(key, type('')):
+        return 's' + repr(key)
+    if isinstance(key, tuple):
+        return '(' + ','.join(_partition_repr(k) for k in key) + ')'
+    raise TypeError('partition key must be a str, int, float or a tuple of those: ' + repr(type(key)))
+
 def _spl_boolean_to_bool(v):
     return not v == 'false'
 
@@ -23,6 +23,13 @@ from __future__ import (absolute_import, division,
 _spl_dict = dict
 _spl_object = object
 
+class _spl_view(object):
+    """Style for stream tuples passed as a read-only view
+    of the SPL tuple. The view is created by Python C-API
+    code so this class only represents the style.
+    """
+    pass
+
 from future.builtins import *
 from past.builtins import basestring, unicode
 
@@ -320,6 +327,7 @@ class StreamSchema(object) :
             self._types = parser._parse()
 
         self._style = self._default_style()
+        self._buffers = False
             
     def _set(self, schema):
         """Set a schema from another schema"""
@@ -327,10 +335,12 @@ class StreamSchema(object) :
             self.__spl_type = False
             self.__schema = schema.schema()
             self._style = self._default_style()
+            self._buffers = False
         else:
             self.__spl_type = schema.__spl_type
             self.__schema = schema.__schema
             self._style = schema._style
+            self._buffers = schema._buffers
 
     @property
     def style(self):
@@ -354,11 +364,14 @@ class StreamSchema(object) :
 
             * ``namedtuple`` - Stream tuples are passed as a named tuple (see ``collections.namedtuple``) with the value being the attributes value in order. Field names correspond to the attribute names of the schema. A schema is set to pass stream tuples as named tuples using :py:meth:`as_tuple` setting the `named` parameter.
 
+            * ``view`` - Stream tuples are passed as a read-only mapping of attribute name to value, with attribute values only converted to Python when accessed. A schema is set to pass stream tuples as views using :py:meth:`as_view`.
+
         Returns:
             type: Class of tuples that will be passed into callables.
 
         .. versionadded:: 1.8
         .. versionadded:: 1.9 Support for namedtuple.
+        .. versionadded:: 1.11 Support for view.
         """
         return self._style
 
@@ -367,16 +380,19 @@ class StreamSchema(object) :
             return _spl_dict
         return _SCHEMA_COMMON_STYLES[self.schema()] if is_common(self) else _spl_dict
 
-    def _copy(self, style=None):
+    def _copy(self, style=None, buffers=None):
         if style is None:
-            return self
-        if self._style is style:
+            style = self._style
+        if buffers is None:
+            buffers = self._buffers
+        if self._style is style and self._buffers == buffers:
             return self
         # Cannot change style of common schemas
         if is_common(self):
             return self
         c = StreamSchema(self.schema())
         c._style = style
+        c._buffers = buffers
         return c
 
     def _make_named_tuple(self, name):
@@ -464,6 +480,82 @@ class StreamSchema(object) :
         """
         return self._copy(_spl_dict)
 
+    def as_view(self):
+        """
+        Create a structured schema that will pass stream tuples into callables as read-only views.
+
+        A view is a mapping of attribute name to value that converts
+        an attribute's value to a Python object only when it is accessed,
+        which avoids converting every attribute of a wide schema when a
+        callable only uses a few of them. For example with a structured
+        schema of ``tuple<rstring id, float64 value>`` the first attribute
+        is accessed as ``t['id']``, ``t.id`` or ``t[0]`` where ``t``
+        represents the passed value.
+
+        A view supports ``len``, ``in``, iteration over the attribute names,
+        ``keys()``, ``values()``, ``items()``, ``get()`` and ``_asdict()``
+        which returns the stream tuple as a ``dict``. A view retained
+        by a callable after it returns (for example in a window) remains
+        valid, its remaining attributes are converted when the callable returns.
+        A view is pickled as a ``dict``.
+
+        If this instance represents a common schema then it will be returned
+        without modification. Stream tuples with common schemas are always passed according
+        to their definition.
+
+        Schemas containing ``blob`` attributes are not supported.
+
+        Returns:
+            StreamSchema: Schema passing stream tuples as views if allowed.
+
+        .. versionadded:: 1.11
+        """
+        return self._copy(_spl_view)
+
+    def with_buffers(self, buffers=True):
+        """
+        Create a structured schema that passes numeric list attributes into callables as ``memoryview`` instances.
+
+        When `buffers` is ``True`` an attribute with a type of
+        ``list<T>`` where `T` is a signed or unsigned integer
+        or a binary floating point type (for example ``list<float64>``)
+        is passed as a read-only ``memoryview`` of the list's values
+        instead of a ``list``. The ``memoryview`` has a format matching
+        the element type (for example ``'d'`` for ``float64``) and refers
+        to the stream tuple's values without copying them, which avoids
+        creating a Python object for each element of large lists.
+        For example ``numpy.frombuffer(t['values'])`` creates a ``numpy``
+        array without any copy.
+
+        The ``memoryview`` is only valid during the call to the callable,
+        it is released when the callable returns. A callable that retains
+        the values must take a copy, for example with ``array.array('d', v)``.
+        Thus this option is not supported for
+        :py:meth:`~streamsx.topology.topology.Window.aggregate`.
+
+        The option applies to stream tuples passed as ``dict``, ``tuple``
+        or named tuple instances and is only supported with Python 3,
+        with Python 2.7 numeric lists are always passed as ``list``.
+        Bounded lists are always passed as ``list``.
+
+        Independent of this option, a numeric list attribute is set from any
+        Python object supporting the buffer protocol with contiguous values of the
+        same kind and size as the list's element type, such as an ``array.array``,
+        ``memoryview`` or ``numpy`` array, with a single copy of the values.
+
+        If this instance represents a common schema then it will be returned
+        without modification.
+
+        Args:
+            buffers(bool): Pass numeric lists as ``memoryview`` instances.
+
+        Returns:
+            StreamSchema: Schema passing numeric list attributes as ``memoryview`` if allowed.
+
+        .. versionadded:: 1.11
+        """
+        return self._copy(buffers=bool(buffers))
+
     def schema(self):
         """Private method. May be removed at any time."""
         return self.__schema
@@ -523,10 +615,14 @@ class StreamSchema(object) :
             ntp = 'tuple'
         elif schema.style is _spl_dict:
             ntp = 'dict'
+        elif schema.style is _spl_view:
+            ntp = 'view'
         elif _is_namedtuple(schema.style) and hasattr(schema.style, '_splpy_namedtuple'):
             ntp = 'namedtuple:' + schema.style._splpy_namedtuple
         else:
             return
+        if schema._buffers and ntp != 'view' and ntp != 'pending':
+            ntp += ';buffers'
         op.params[name] = ntp
 
 
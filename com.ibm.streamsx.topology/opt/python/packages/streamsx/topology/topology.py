@@ -840,7 +840,7 @@ class Stream(_placement._Placement, object):
         """
         return self.for_each(func, name)
 
-    def filter(self, func, name=None):
+    def filter(self, func, name=None, batch_size=None, max_linger=None, vectorized=False):
         """
         Filters tuples from this stream using the supplied callable `func`.
 
@@ -850,6 +850,13 @@ class Stream(_placement._Placement, object):
         Args:
             func: Filter callable that takes a single parameter for the tuple.
             name(str): Name of the stream, defaults to a generated name.
+            batch_size(int): Maximum number of tuples ``func`` is invoked
+                for as a single batch, defaults to no batching.
+            max_linger: Maximum time a tuple waits in an incomplete batch,
+                either a `datetime.timedelta` or a `float` in seconds.
+                Only valid when `batch_size` is set.
+            vectorized(bool): ``func`` is passed each batch of tuples
+                and returns its selection. Only valid when `batch_size` is set.
 
         If invoking ``func`` for a tuple on the stream raises an exception
         then its processing element will terminate. By default the processing
@@ -860,17 +867,45 @@ class Stream(_placement._Placement, object):
         exception is suppressed no tuple is submitted to the filtered
         stream corresponding to the input tuple that caused the exception.
 
+        When `batch_size` is set ``func`` is evaluated for a batch of
+        tuples with the GIL held once per batch, producing a selection
+        of the batch's tuples that are submitted in order once
+        the GIL is released. Batches are completed as
+        described for :py:meth:`map`.
+
+        When `vectorized` is `True` ``func`` is called once per batch
+        with a `list` of the batch's tuples, and returns a selection with
+        one entry per tuple, true for a tuple that is present on the
+        returned stream. The selection may be a sequence, or a buffer
+        of single byte items such as ``bytes`` or a ``numpy`` boolean
+        array which is used without conversion, a non-zero byte selecting
+        its tuple. For example::
+
+            hot = readings.filter(lambda b : numpy.array([r['temp'] for r in b]) > 30.0,
+                batch_size=1000, vectorized=True)
+
+        If an exception raised by a vectorized ``func`` is suppressed
+        then none of the batch's tuples are present on the returned stream.
+        A vectorized ``func`` cannot be invoked in worker processes.
+
         Returns:
             Stream: A Stream containing tuples that have not been filtered out.
+
+        .. versionadded:: 1.11 `batch_size`, `max_linger` and `vectorized` arguments.
         """
+        if vectorized and batch_size is None:
+            raise ValueError("vectorized requires batch_size")
         sl = _SourceLocation(_source_info(), 'filter')
         _name = self.topology.graph._requested_name(name, action="filter", func=func)
         stateful = self._determine_statefulness(func)
+        if vectorized:
+            func = streamsx.topology.runtime._VectorizedFilter(func)
         op = self.topology.graph.addOperator(self.topology.opnamespace+"::Filter", func, name=_name, sl=sl, stateful=stateful)
         op.addInputPort(outputPort=self.oport)
         streamsx.topology.schema.StreamSchema._fnop_style(self.oport.schema, op, 'pyStyle')
         op._layout(kind='Filter', name=_name, orig_name=name)
         oport = op.addOutputPort(schema=self.oport.schema, name=_name)
+        self._set_batch(op, batch_size, max_linger)
         return Stream(self.topology, oport)._make_placeable()
 
     def _map(self, func, schema, name=None):
@@ -936,7 +971,7 @@ class Stream(_placement._Placement, object):
         self.topology.graph.get_views().append(_view)
         return _view
 
-    def map(self, func=None, name=None, schema=None):
+    def map(self, func=None, name=None, schema=None, batch_size=None, max_linger=None):
         """
         Maps each tuple from this stream into 0 or 1 stream tuples.
 
@@ -960,6 +995,11 @@ class Stream(_placement._Placement, object):
                 If not supplied then a function equivalent to ``lambda tuple_ : tuple_`` is used.
             name(str): Name of the mapped stream, defaults to a generated name.
             schema(StreamSchema): Schema of the resulting stream.
+            batch_size(int): Maximum number of tuples ``func`` is invoked
+                for as a single batch, defaults to no batching.
+            max_linger: Maximum time a tuple waits in an incomplete batch,
+                either a `datetime.timedelta` or a `float` in seconds.
+                Only valid when `batch_size` is set.
 
         If invoking ``func`` for a tuple on the stream raises an exception
         then its processing element will terminate. By default the processing
@@ -969,6 +1009,14 @@ class Stream(_placement._Placement, object):
         by return a true value from its ``__exit__`` method. When an
         exception is suppressed no tuple is submitted to the mapped
         stream corresponding to the input tuple that caused the exception.
+
+        When `batch_size` is set tuples are collected into batches and
+        ``func`` is called for each tuple of a batch in turn with
+        the GIL held once per batch, reducing the per-tuple overhead
+        of invoking Python. A batch is completed when it
+        contains `batch_size` tuples, when a window punctuation
+        arrives or when `max_linger` has passed since its first tuple
+        arrived. The order of tuples is maintained.
        
 
         Returns:
@@ -978,6 +1026,7 @@ class Stream(_placement._Placement, object):
             a structured stream.
         .. versionadded:: 1.8 Support for submitting `dict` objects as stream tuples to a structured stream (in addition to existing support for `tuple` objects).
         .. versionchanged:: 1.11 `func` is optional.
+        .. versionadded:: 1.11 `batch_size` and `max_linger` arguments.
         """
         if schema is None:
             schema = streamsx.topology.schema.CommonSchema.Python
@@ -988,6 +1037,7 @@ class Stream(_placement._Placement, object):
      
         ms = self._map(func, schema=schema, name=name)._layout('Map')
         ms.oport.operator.sl = _SourceLocation(_source_info(), 'map')
+        self._set_batch(ms.oport.operator, batch_size, max_linger)
         return ms
 
     def transform(self, func, name=None):
@@ -1217,6 +1267,226 @@ class Stream(_placement._Placement, object):
         self.oport.operator.config['width'] = streamsx.topology.graph._as_spl_json(width, int)
         return self
 
+    def set_shared_memory(self, size):
+        """
+        Pass Python objects on this stream to downstream Python
+        functions in other processing elements on the same host
+        through shared memory.
+
+        By default Python objects on a stream that crosses a processing
+        element boundary are pickled into each tuple. With shared memory
+        the pickled value is written once into a shared memory arena of
+        `size` megabytes and each tuple only carries a reference to it,
+        avoiding copying the pickled bytes through the transport.
+
+        Values smaller than one kilobyte, or values that do not fit
+        in the arena, are still pickled into the tuple.
+        Shared memory is only used when all operations consuming this
+        stream are Python functions, such as :py:meth:`map` or
+        :py:meth:`for_each`, and these must be placed on the same host
+        as the operation producing this stream. Each reference carries
+        a random token of the arena, a consuming processing element
+        on a different host fails rather than use an arena of another
+        producer with the same name.
+
+        Should only be invoked on a stream of
+        :py:const:`Python objects <streamsx.topology.schema.CommonSchema.Python>`
+        produced by :py:meth:`Topology.source`, :py:meth:`map` or :py:meth:`flat_map`.
+
+        Args:
+            size(int): Size of the shared memory arena in megabytes.
+
+        Returns:
+            Stream: Returns this stream.
+
+        .. versionadded:: 1.11
+        """
+        size = int(size)
+        if size < 1:
+            raise ValueError("size must be 1 or greater")
+        op = self._python_object_op("Shared memory")
+        op.params['sharedMemory'] = size
+        return self
+
+    def set_codec(self, codec):
+        """
+        Set the codec encoding Python objects on this stream when
+        they are passed to downstream Python functions in other
+        processing elements.
+
+        By default Python objects on a stream that crosses a processing
+        element boundary are pickled into each tuple. The ``msgpack``
+        codec instead encodes objects made of ``None``, ``bool``, ``int``,
+        ``float``, ``str``, ``bytes``, ``list``, ``tuple`` and ``dict``
+        values in the `MessagePack <https://msgpack.org>`_ format,
+        without calling Python code. Objects the codec does not
+        support are pickled.
+
+        The codec is not used when objects are passed by reference
+        to Python functions in the same processing element, and
+        values encoded by a codec are not passed through
+        shared memory (:py:meth:`set_shared_memory`).
+        The ``msgpack`` codec requires Python 3, objects are pickled
+        with Python 2.
+
+        Should only be invoked on a stream of
+        :py:const:`Python objects <streamsx.topology.schema.CommonSchema.Python>`
+        produced by :py:meth:`Topology.source`, :py:meth:`map` or :py:meth:`flat_map`.
+
+        Args:
+            codec(str): Name of the codec, ``msgpack``, or ``pickle`` for the default pickle encoding.
+
+        Returns:
+            Stream: Returns this stream.
+
+        .. versionadded:: 1.11
+        """
+        if codec not in ('msgpack', 'pickle'):
+            raise ValueError("Unknown codec: " + str(codec))
+        op = self._python_object_op("A codec")
+        if codec == 'pickle':
+            op.params.pop('pyCodec', None)
+        else:
+            op.params['pyCodec'] = codec
+        return self
+
+    def set_subinterpreter(self):
+        """
+        Execute the Python function producing this stream in its own
+        Python sub-interpreter.
+
+        By default all Python functions in a processing element execute
+        in a single Python interpreter and share its modules and global
+        state. A function executing in a sub-interpreter has its own
+        modules, including its own ``sys.path`` and ``sys.modules``.
+        Each channel of a parallel region has its own sub-interpreter.
+
+        Python objects are not passed by reference to or from a function
+        executing in a sub-interpreter, they are pickled as they are when
+        the stream crosses a processing element boundary. Extension
+        modules that do not support sub-interpreters cannot be used by
+        the function. All interpreters share the global interpreter lock.
+
+        Should only be invoked on a stream produced by
+        :py:meth:`Topology.source`, :py:meth:`map`, :py:meth:`flat_map`
+        or :py:meth:`filter`.
+
+        Returns:
+            Stream: Returns this stream.
+
+        .. versionadded:: 1.11
+        """
+        op = self.oport.operator
+        if not op.kind.startswith('com.ibm.streamsx.topology.functional.python') or \
+            not op.kind.endswith(('::Source', '::Map', '::FlatMap', '::Filter')):
+            raise TypeError("A sub-interpreter requires a stream produced by source, map, flat_map or filter")
+        op.params['subinterpreter'] = True
+        return self
+
+    def set_workers(self, count):
+        """
+        Invoke the Python function producing this stream in a pool
+        of `count` worker Python processes.
+
+        Because of the global interpreter lock Python code in a
+        processing element only executes on a single core at a time.
+        With worker processes each batch of tuples is split across
+        the workers and the function is invoked for the batch on
+        multiple cores, allowing a CPU bound function to scale
+        without a parallel region. The returns are submitted in the
+        order of the batch's tuples.
+
+        Each worker loads its own instance of the function, thus
+        the state of a callable object is not shared between
+        the workers or checkpointed. Tuples and returned values
+        are pickled to and from the workers. An exception raised
+        by the function in a worker is passed to the ``__exit__``
+        method of the processing element's instance.
+
+        A worker that exits while processing a batch is replaced
+        by a new worker, which processes the worker's tuples one
+        at a time. A tuple that causes the new worker to exit
+        raises ``RuntimeError``, which is passed to ``__exit__``
+        in the same way.
+
+        The execution context (:py:mod:`streamsx.ec`) is not
+        available to the function in a worker, for example
+        custom metrics and job information raise
+        ``NotImplementedError``. Submission parameters are
+        available.
+
+        Should only be invoked on a stream produced by
+        :py:meth:`map` or :py:meth:`filter` with a `batch_size`.
+
+        Args:
+            count(int): Number of worker processes.
+
+        Returns:
+            Stream: Returns this stream.
+
+        .. versionadded:: 1.11
+        """
+        count = int(count)
+        if count < 1:
+            raise ValueError("count must be 1 or greater")
+        op = self.oport.operator
+        if not op.kind.startswith('com.ibm.streamsx.topology.functional.python') or \
+            not op.kind.endswith(('::Map', '::Filter')) or 'batchSize' not in op.params:
+            raise TypeError("Worker processes require a stream produced by map or filter with a batch_size")
+        if isinstance(op.function, streamsx.topology.runtime._VectorizedFilter):
+            raise TypeError("Worker processes are not supported for a vectorized filter")
+        op.params['workers'] = count
+        return self
+
+    def set_submit_queue(self, size):
+        """
+        Submit the tuples returned by the Python function producing
+        this stream from a thread of their own, through a queue
+        holding up to `size` tuples.
+
+        By default a tuple returned by the function is submitted
+        by the thread that invoked the function, including the
+        processing of any downstream operations in the same processing
+        element, before the function is invoked for the next tuple.
+        With a submit queue the submission overlaps with the next
+        invocation of the function. The function waits when the
+        queue is full so that slow downstream processing still
+        throttles it. The order of tuples is maintained. Queued
+        tuples are submitted before a punctuation is forwarded and
+        when a consistent region is drained.
+
+        The operator has metrics ``submitQueueDepth``, the number of
+        tuples in the queue, and ``nSubmitQueueFull``, the number of
+        times the function waited for the queue to have space.
+
+        Should only be invoked on a stream produced by :py:meth:`map`.
+
+        Args:
+            size(int): Maximum number of tuples in the queue.
+
+        Returns:
+            Stream: Returns this stream.
+
+        .. versionadded:: 1.11
+        """
+        size = int(size)
+        if size < 1:
+            raise ValueError("size must be 1 or greater")
+        op = self.oport.operator
+        if not op.kind.startswith('com.ibm.streamsx.topology.functional.python') or \
+            not op.kind.endswith('::Map'):
+            raise TypeError("A submit queue requires a stream produced by map")
+        op.params['submitQueue'] = size
+        return self
+
+    def _python_object_op(self, feature):
+        op = self.oport.operator
+        if self.oport.schema != streamsx.topology.schema.CommonSchema.Python or \
+            not op.kind.startswith('com.ibm.streamsx.topology.functional.python') or \
+            not op.kind.endswith(('::Source', '::Map', '::FlatMap')):
+            raise TypeError(feature + " requires a stream of Python objects produced by source, map or flat_map")
+        return op
+
     def last(self, size=1):
         """ Declares a slding window containing most recent tuples
         on this stream.
@@ -1531,6 +1801,27 @@ class Stream(_placement._Placement, object):
         stateful = not inspect.isroutine(_callable)
         return stateful
 
+    """
+    Set the batching parameters for a functional operator
+    that invokes its callable for batches of tuples.
+    """
+    def _set_batch(self, op, batch_size, max_linger):
+        if batch_size is None:
+            if max_linger is not None:
+                raise ValueError("max_linger requires batch_size")
+            return
+        batch_size = int(batch_size)
+        if batch_size < 1:
+            raise ValueError("batch_size must be 1 or greater")
+        op.params['batchSize'] = batch_size
+        if max_linger is not None:
+            if isinstance(max_linger, datetime.timedelta):
+                max_linger = max_linger.total_seconds()
+            max_linger = float(max_linger)
+            if max_linger <= 0.0:
+                raise ValueError("max_linger must be greater than zero")
+            op.params['batchLinger'] = max_linger
+
 class View(object):
     """
     The View class provides access to a continuously updated sampling of data items on a Stream after submission.
@@ -1675,6 +1966,7 @@ class Window(object):
         self.topology = stream.topology
         self.stream = stream
         self._config = {'type': window_type}
+        self._key = None
 
     def _evict_count(self, size):
         self._config['evictPolicy'] = 'COUNT'
@@ -1728,9 +2020,76 @@ class Window(object):
             tw._config['triggerConfig'] = when
         else:
             raise ValueError(when)
+        tw._copy_partition(self)
         return tw
 
-    def aggregate(self, function, name=None):
+    def _copy_partition(self, window):
+        for pk in ('partitioned', 'partitionAge', 'partitionCount'):
+            if pk in window._config:
+                self._config[pk] = window._config[pk]
+        self._key = window._key
+
+    def partition(self, key, idle=None, max_partitions=None):
+        """Declare a window with this window's policies partitioned by `key`.
+
+        Each partition is a separate window of the tuples with the
+        same key, with this window's eviction and trigger policies
+        applied to each partition independently. When the partitioned
+        window is aggregated the function is passed the contents of the
+        partition that was triggered. For example the average of the last
+        ten readings for each sensor::
+
+            win = readings.last(10).partition('sensor_id')
+            averages = win.aggregate(lambda items : sum(r['value'] for r in items)/len(items))
+
+        If `key` is a `str` then it is the name of an attribute of the
+        stream's structured schema, whose value is the partition key.
+        Otherwise `key` is a callable that is passed each tuple and returns
+        its key, which must be a `str`, `int` or `float` or a `tuple` of
+        those, keys that compare equal being the same partition. A key of
+        any other type raises `TypeError` when the tuple is processed.
+
+        Partitions are maintained by the window until they are evicted,
+        which by default is never. `idle` evicts a partition once no
+        tuple has been inserted into it for the given duration, and
+        `max_partitions` evicts the least recently used partition once
+        there are more than that number of partitions. Only one of
+        `idle` and `max_partitions` may be set.
+
+        Args:
+            key: Attribute name or callable returning a tuple's partition key.
+            idle(datetime.timedelta): Duration after which an idle partition is evicted.
+            max_partitions(int): Maximum number of partitions.
+
+        Returns:
+            Window: Window partitioned by `key`.
+
+        .. versionadded:: 1.11
+        """
+        if not isinstance(key, str) and not callable(key):
+            raise TypeError("key must be an attribute name or a callable")
+        if isinstance(key, str) and streamsx.topology.schema.is_common(self.stream.oport.schema):
+            raise TypeError("partition by attribute requires a stream with a structured schema")
+        if idle is not None and max_partitions is not None:
+            raise ValueError("only one of idle and max_partitions may be set")
+
+        pw = Window(self.stream, self._config['type'])
+        pw._config.update(self._config)
+        pw._config.pop('partitionAge', None)
+        pw._config.pop('partitionCount', None)
+        pw._config['partitioned'] = True
+        pw._key = key
+        if idle is not None:
+            if not isinstance(idle, datetime.timedelta):
+                raise TypeError(idle)
+            pw._config['partitionAge'] = idle.total_seconds()
+        elif max_partitions is not None:
+            if max_partitions < 1:
+                raise ValueError(max_partitions)
+            pw._config['partitionCount'] = int(max_partitions)
+        return pw
+
+    def aggregate(self, function, name=None, columns=False, lazy=False):
         """Aggregates the contents of the window when the window is
         triggered.
         
@@ -1751,10 +2110,36 @@ class Window(object):
             for a window sized using a count. For example a stream with 105
             tuples and a batch size of 25 tuples will perform four aggregations
             with 25 tuples each and a final aggregation of 5 tuples.
-            
+
+        When the stream has a structured schema and `columns` is `True`
+        the window holds the SPL tuples rather than a Python object per tuple,
+        reducing the window's memory, and the function is passed the contents
+        by column. With a `dict` style the function is passed a `dict`
+        mapping each attribute name to its column, with a tuple style a
+        `tuple` (or named tuple) of columns in attribute order. A column of
+        a numeric attribute (integer or binary floating point) is an
+        ``array.array`` supporting the buffer protocol, so that it can be
+        passed to ``numpy.frombuffer`` without a copy. Any other column is a
+        `list`. For example a moving average of the ``temp`` attribute::
+
+            win = readings.last(100).trigger(10)
+            avg = win.aggregate(lambda c: sum(c['temp'])/len(c['temp']), columns=True)
+
+        When the stream contains Python objects and `lazy` is `True` the
+        window holds each tuple's pickled bytes and a Python object is
+        only depickled when it is first passed to `function`. Each object
+        is depickled at most once and objects evicted from the window before
+        it is triggered are never depickled, for example a count window
+        of the last 1,000 tuples triggered every 10,000 tuples.
+
+        When the window is partitioned (:py:meth:`partition`) `function`
+        is passed the contents of the partition that was triggered.
+
         Args:
             function: The function which aggregates the contents of the window
             name(str): The name of the returned stream. Defaults to a generated name.
+            columns(bool): Pass the contents of the window to `function` by column.
+            lazy(bool): Depickle the contents of the window when first aggregated.
 
         Returns: 
             Stream: A `Stream` of the returned values of the supplied function.
@@ -1771,15 +2156,101 @@ class Window(object):
 
         .. versionadded:: 1.8
         .. versionchanged:: 1.11 Support for aggregation of streams with structured schemas.
+        .. versionchanged:: 1.11 `columns` and `lazy` parameters added.
         """
         schema = streamsx.topology.schema.CommonSchema.Python
+        if columns:
+            iss = self.stream.oport.schema
+            if streamsx.topology.schema.is_common(iss):
+                raise TypeError("columns requires a stream with a structured schema")
+            if not streamsx.topology.schema._is_pending(iss) and \
+                (iss.style is streamsx.topology.schema._spl_view or iss._buffers):
+                raise TypeError("columns requires a stream with a structured schema and dict or tuple style")
+        if lazy:
+            iss = self.stream.oport.schema
+            if iss != streamsx.topology.schema.CommonSchema.Python and not streamsx.topology.schema._is_pending(iss):
+                raise TypeError("lazy requires a stream of Python objects")
+        key_fn = self._key is not None and not isinstance(self._key, str)
+        if key_fn and (columns or lazy):
+            raise TypeError("a partition key callable is not supported with columns or lazy")
         
         sl = _SourceLocation(_source_info(), "aggregate")
         _name = self.topology.graph._requested_name(name, action="aggregate", func=function)
         stateful = self.stream._determine_statefulness(function)
+        if key_fn:
+            stateful = stateful or self.stream._determine_statefulness(self._key)
+            function = streamsx.topology.runtime._PartitionedAggregate(function, self._key)
         op = self.topology.graph.addOperator(self.topology.opnamespace+"::Aggregate", function, name=_name, sl=sl, stateful=stateful)
         op.addInputPort(outputPort=self.stream.oport, window_config=self._config)
         streamsx.topology.schema.StreamSchema._fnop_style(self.stream.oport.schema, op, 'pyStyle')
+        if columns:
+            op.params['columns'] = True
+        if lazy:
+            op.params['lazy'] = True
+        if key_fn:
+            op.params['pyPartitionKey'] = True
+        elif self._key is not None:
+            op.params['partitionBy'] = self._key
+        oport = op.addOutputPort(schema=schema, name=_name)
+        op._layout(kind='Aggregate', name=_name, orig_name=name)
+        return Stream(self.topology, oport)._make_placeable()
+
+    def accumulate(self, accumulator, name=None):
+        """Aggregates the contents of the window incrementally
+        when the window is triggered.
+
+        Unlike :py:meth:`aggregate`, the window's contents are not
+        passed to a function at each trigger. Instead `accumulator`
+        maintains the aggregation as tuples enter and leave the window:
+
+            * ``accumulator.add(item)`` is called when a tuple is inserted into the window.
+            * ``accumulator.remove(item)`` is called when a tuple is evicted from the window,
+              including the tuples of a tumbling (:py:meth:`~Stream.batch`) window after it
+              is triggered.
+            * ``accumulator.result()`` is called when the window is triggered. If its return
+              value is not `None` then the result will be submitted as a tuple on the
+              returned stream.
+
+        Thus the cost of a trigger is independent of the size of the window,
+        for example a moving sum of the tuples from the last ten minutes
+        triggered every second could be written as follows::
+
+            class Sum(object):
+                def __init__(self):
+                    self.total = 0
+                def add(self, item):
+                    self.total += item
+                def remove(self, item):
+                    self.total -= item
+                def result(self):
+                    return self.total
+
+            win = s.last(datetime.timedelta(minutes=10)).trigger(datetime.timedelta(seconds=1))
+            sums = win.accumulate(Sum())
+
+        Args:
+            accumulator: Instance of a class with ``add``, ``remove`` and ``result`` methods.
+            name(str): The name of the returned stream. Defaults to a generated name.
+
+        Returns:
+            Stream: A `Stream` of the results of the accumulator.
+
+        .. versionadded:: 1.11
+        """
+        for method in ('add', 'remove', 'result'):
+            if not callable(getattr(accumulator, method, None)):
+                raise TypeError("accumulator must have a " + method + " method")
+        if self._key is not None:
+            raise TypeError("accumulate does not support a partitioned window")
+        schema = streamsx.topology.schema.CommonSchema.Python
+
+        sl = _SourceLocation(_source_info(), "accumulate")
+        _name = self.topology.graph._requested_name(name, action="accumulate", func=accumulator)
+        function = streamsx.topology.runtime._Accumulator(accumulator)
+        op = self.topology.graph.addOperator(self.topology.opnamespace+"::Aggregate", function, name=_name, sl=sl, stateful=True)
+        op.params['incremental'] = True
+        op.addInputPort(outputPort=self.stream.oport, window_config=self._config)
+        streamsx.topology.schema.StreamSchema._fnop_style(self.stream.oport.schema, op, 'pyStyle')
         oport = op.addOutputPort(schema=schema, name=_name)
         op._layout(kind='Aggregate', name=_name, orig_name=name)
         return Stream(self.topology, oport)._make_placeable()
@@ -38,9 +38,9 @@ class Stream(object):
     def name(self) -> str: ...
     def for_each(self, func: Callable[[Any],None], name: str=None) -> 'Sink': ...
     def sink(self, func: Callable[[Any], None], name: str=None) -> 'Sink': ...
-    def filter(self, func: Callable[[Any], bool], name: str=None) -> 'Stream': ...
+    def filter(self, func: Callable[[Any], bool], name: str=None, batch_size: int=None, max_linger: Union[float, datetime.timedelta]=None, vectorized: bool=False) -> 'Stream': ...
     def view(self, buffer_time: float=10.0, sample_size: int=10000, name: str=None, description: str=None, start: bool=True) -> View: ...
-    def map(self, func: Callable[[Any], Any]=None, name: Any=None, schema: _AnySchema=None) -> 'Stream': ...
+    def map(self, func: Callable[[Any], Any]=None, name: Any=None, schema: _AnySchema=None, batch_size: int=None, max_linger: Union[float, datetime.timedelta]=None) -> 'Stream': ...
     def transform(self, func: Callable[[Any], Any], name: str=None) -> 'Stream': ...
     def flat_map(self, func: Callable[[Any], Any]=None, name: str=None) -> 'Stream': ...
     def multi_transform(self, func: Any, name: str=None) -> 'Stream': ...
@@ -59,6 +59,11 @@ class Stream(object):
     def as_string(self, name: str=None) -> 'Stream': ...
     def as_json(self, force_object: Any=bool, name: str=None) -> 'Stream': ...
     def resource_tags(self) -> Any: ...
+    def set_shared_memory(self, size: int) -> 'Stream': ...
+    def set_codec(self, codec: str) -> 'Stream': ...
+    def set_subinterpreter(self) -> 'Stream': ...
+    def set_workers(self, count: int) -> 'Stream': ...
+    def set_submit_queue(self, size: int) -> 'Stream': ...
 
 
 class View(object):
@@ -77,5 +82,7 @@ class Sink(object): ...
 
 class Window(object):
     def trigger(self, when: Union[int,datetime.timedelta]=1) -> 'Window': ...
-    def aggregate(self, function: Callable[[List[Any]], Any], name: str=None, schema: _AnySchema=None) -> 'Stream': ...
+    def partition(self, key: Union[str, Callable[[Any], Any]], idle: datetime.timedelta=None, max_partitions: int=None) -> 'Window': ...
+    def aggregate(self, function: Callable[[List[Any]], Any], name: str=None, columns: bool=False, lazy: bool=False) -> 'Stream': ...
+    def accumulate(self, accumulator: Any, name: str=None) -> 'Stream': ...
 
@@ -463,9 +463,21 @@ class OperatorGenerator {
                 appendWindowPolicy(triggerPolicy, window.get("triggerConfig"), jstring(window, "triggerTimeUnit"), sb);
             }
 
-            if (jboolean(window, "partitioned"))
+            if (jboolean(window, "partitioned")) {
                 sb.append(", partitioned");
 
+                // Optional partition eviction policy
+                if (window.has("partitionAge")) {
+                    sb.append(", partitionAge(");
+                    sb.append(window.get("partitionAge").getAsDouble());
+                    sb.append(")");
+                } else if (window.has("partitionCount")) {
+                    sb.append(", partitionCount(");
+                    sb.append(window.get("partitionCount").getAsInt());
+                    sb.append(")");
+                }
+            }
+
             sb.append(";\n");
         });
 
@@ -8,6 +8,7 @@ import static com.ibm.streamsx.topology.generator.spl.GraphUtilities.findOperato
 import static com.ibm.streamsx.topology.generator.spl.GraphUtilities.getDownstream;
 import static com.ibm.streamsx.topology.generator.spl.GraphUtilities.kind;
 import static com.ibm.streamsx.topology.internal.gson.GsonUtilities.array;
+import static com.ibm.streamsx.topology.internal.gson.GsonUtilities.jobject;
 import static com.ibm.streamsx.topology.internal.gson.GsonUtilities.jstring;
 
 import java.util.HashSet;
@@ -49,6 +50,8 @@ class Optimizer {
      * parameter representing the number of connections.
      * 
      * If pass by reference cannot be used outputConnections will not be set.
+     * Objects are not passed by reference to or from an operator
+     * executing in its own Python sub-interpreter.
      * 
      * Does not modify the structure of the graph.
      * Assumes the graph's structure will not be subsequently modified.
@@ -63,6 +66,8 @@ class Optimizer {
             JsonArray outputs = array(pyop, "outputs");
             if (outputs == null || outputs.size() == 0)
                 continue;
+            if (pySubinterpreter(pyop))
+                continue;
 
             // Currently only supporting a single output port
             // though mostly coded to support N.
@@ -94,6 +99,10 @@ class Optimizer {
                         canPassByRef = false;
                         break;
                     }
+                    if (pySubinterpreter(connectedOp)) {
+                        canPassByRef = false;
+                        break;
+                    }
                         
                         // TEMP
                         // Currently only Map and ForEach completly handle
@@ -131,4 +140,12 @@ class Optimizer {
             }
         }
     }
+
+    /**
+     * Does a Python operator execute in its own sub-interpreter.
+     */
+    private static boolean pySubinterpreter(JsonObject pyop) {
+        JsonObject params = jobject(pyop, "parameters");
+        return params != null && params.has("subinterpreter");
+    }
 }
@@ -24,6 +24,12 @@ def _create_tf():
         fp.flush()
         return fp.name
 
+def _record(tf):
+    def _append(t):
+        with open(tf, 'a') as fp:
+            fp.write(t['a'] + ' ' + str(t['b']) + '\n')
+    return _append
+
 
 class TestBaseExceptions(unittest.TestCase):
     """ Test exceptions in callables
@@ -56,7 +62,7 @@ class TestBaseExceptions(unittest.TestCase):
 class TestExceptions(TestBaseExceptions):
     _multiprocess_can_split_ = False
 
-    def _run_app(self, kind, opi='M'):
+    def _run_app(self, kind, opi='M', sink=None):
         schema = 'tuple<rstring a, int32 b>'
         topo = Topology('TESPL' + str(uuid.uuid4().hex))
         streamsx.spl.toolkit.add_toolkit(topo, stu._tk_dir('testtkpy'))
@@ -84,6 +90,9 @@ class TestExceptions(TestBaseExceptions):
                 se, params={'tf':self.tf})
             res = None
 
+        if sink is not None:
+            res.for_each(sink)
+
         tester = Tester(topo)
         tester.run_for(3)
         ok = tester.test(self.test_ctxtype, self.test_config, assert_on_fail=False)
@@ -109,6 +118,14 @@ class TestExceptions(TestBaseExceptions):
         self.assertEqual('__exit__\n', content[3])
         self.assertEqual('KeyError\n', content[4])
 
+    def test_exc_list_map(self):
+        # Tuple before the failing value is submitted
+        self._run_app('ExcListMap', sink=_record(self.tf))
+        content = self._result(6)
+        self.assertEqual('helloLM 1\n', content[3])
+        self.assertEqual('__exit__\n', content[4])
+        self.assertEqual('TypeError\n', content[5])
+
     def test_exc_enter_for_each(self):
         self._run_app('ExcEnterForEach', opi='E')
         self._result(3)
@@ -208,6 +225,17 @@ class TestSuppressExceptions(TestBaseExceptions):
         self.assertEqual('ValueError\n', content[4])
         self.assertEqual('__exit__\n', content[5])
 
+    def test_suppress_list_map(self):
+        self._run_app('SuppressListMap',
+            [{'a':'helloLM', 'b':1}, {'a':'helloLM', 'b':11},
+             {'a':'helloLM', 'b':2}, {'a':'helloLM', 'b':12},
+             {'a':'helloLM', 'b':3}, {'a':'helloLM', 'b':13}])
+        content = self._result(10)
+        for i in range(3):
+            self.assertEqual('__exit__\n', content[3+i*2])
+            self.assertEqual('TypeError\n', content[4+i*2])
+        self.assertEqual('__exit__\n', content[9])
+
     def test_suppress_for_each(self):
         self._run_app('SuppressForEach', None, opi='E')
         content = self._result(6)
@@ -0,0 +1,87 @@
+# coding=utf-8
+# Licensed Materials - Property of IBM
+# Copyright IBM Corp. 2018
+from __future__ import print_function
+import unittest
+import tempfile
+import os
+import uuid
+
+from streamsx.topology.topology import *
+from streamsx.topology.tester import Tester
+
+import streamsx.spl.toolkit
+import streamsx.spl.op as op
+
+import spl_tests_utils as stu
+
+def _create_tf():
+    with tempfile.NamedTemporaryFile(delete=False) as fp:
+        return fp.name
+
+class TestStageMetrics(unittest.TestCase):
+    """ Test the stage metrics of the SPL Python operators,
+    sampling every tuple.
+    """
+    _multiprocess_can_split_ = False
+
+    @classmethod
+    def setUpClass(cls):
+        """Extract Python operators in toolkit"""
+        stu._extract_tk('testtkpy')
+
+    def setUp(self):
+        self.tf = _create_tf()
+        Tester.setup_standalone(self)
+        os.environ['STREAMSX_PYTHON_STAGE_SAMPLE'] = '1'
+
+    def tearDown(self):
+        del os.environ['STREAMSX_PYTHON_STAGE_SAMPLE']
+        if self.tf:
+            os.remove(self.tf)
+
+    def _run_app(self, kind, opi='M'):
+        # Metrics are published every 64 samples.
+        n = 200
+        schema = 'tuple<rstring a, int32 b>'
+        topo = Topology('TSMSPL' + str(uuid.uuid4().hex))
+        streamsx.spl.toolkit.add_toolkit(topo, stu._tk_dir('testtkpy'))
+        se = topo.source(range(n+1))
+        se = se.map(lambda x : {'a':'hello', 'b':x} , schema=schema)
+        params = {'tf':self.tf, 'n':n}
+        if opi == 'M':
+            prim = op.Map(
+                "com.ibm.streamsx.topology.pytest.pymetrics::" + kind,
+                se, params=params)
+        elif opi == 'E':
+            prim = op.Sink(
+                "com.ibm.streamsx.topology.pytest.pymetrics::" + kind,
+                se, params=params)
+
+        tester = Tester(topo)
+        if opi == 'M':
+            tester.tuple_count(prim.stream, n+1)
+        else:
+            tester.run_for(3)
+        tester.test(self.test_ctxtype, self.test_config)
+
+    def _result(self, submitted=True):
+        with open(self.tf) as fp:
+            content = fp.readlines()
+        self.assertEqual(4, len(content), msg=str(content))
+        self.assertEqual('toPythonNanos True\n', content[0])
+        self.assertEqual('callNanos True\n', content[1])
+        self.assertEqual('fromPythonNanos True\n', content[2])
+        self.assertEqual('submitNanos ' + str(submitted) + '\n', content[3])
+
+    def test_stage_metrics_map(self):
+        self._run_app('StageMetricsMap')
+        self._result()
+
+    def test_stage_metrics_filter(self):
+        self._run_app('StageMetricsFilter')
+        self._result()
+
+    def test_stage_metrics_for_each(self):
+        self._run_app('StageMetricsForEach', opi='E')
+        self._result(submitted=False)
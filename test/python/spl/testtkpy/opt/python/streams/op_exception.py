@@ -86,6 +86,22 @@ class SuppressMap(EnterExit):
         EnterExit.__exit__(self, exc_type, exc_value, traceback)
         return exc_type == ValueError
 
+# Returns a list with a value that cannot be converted
+# to an output tuple between two valid values.
+class ListWithBadValue(EnterExit):
+    def __call__(self, *t):
+        return [(t[0]+'LM', t[1]), (t[0], 'INTENTIONAL_ERROR'), (t[0]+'LM', t[1]+10)]
+
+@spl.map()
+class ExcListMap(ListWithBadValue):
+    pass
+
+@spl.map()
+class SuppressListMap(ListWithBadValue):
+    def __exit__(self, exc_type, exc_value, traceback):
+        EnterExit.__exit__(self, exc_type, exc_value, traceback)
+        return exc_type == TypeError
+
 @spl.for_each()
 class ExcEnterForEach(ExcOnEnter):
     def __call__(self, *t):
@@ -0,0 +1,57 @@
+# coding=utf-8
+# Licensed Materials - Property of IBM
+# Copyright IBM Corp. 2018
+
+# Import the SPL decorators
+from streamsx.spl import spl
+import streamsx.ec as ec
+
+#------------------------------------------------------------------
+# Test the stage metrics of the SPL Python operators
+#------------------------------------------------------------------
+
+def spl_namespace():
+    return "com.ibm.streamsx.topology.pytest.pymetrics"
+
+_STAGES = ['toPythonNanos', 'callNanos', 'fromPythonNanos', 'submitNanos']
+
+class StageMetrics(object):
+    """ Report the operator's stage metrics to a file when
+    the tuple with b equal to n is processed. A metric that was
+    not created by the operator would be created here with a
+    value of zero.
+    """
+    def __init__(self, tf, n):
+        self.tf = tf
+        self.n = n
+
+    def __enter__(self):
+        self.metrics = [ec.CustomMetric(self, name, kind=ec.MetricKind.Gauge) for name in _STAGES]
+
+    def __exit__(self, exc_type, exc_value, traceback):
+        pass
+
+    def _report(self, b):
+        if b != self.n:
+            return
+        with open(self.tf, 'a') as fp:
+            for m in self.metrics:
+                fp.write(m.name + ' ' + str(m.value > 0) + '\n')
+            fp.flush()
+
+@spl.map()
+class StageMetricsMap(StageMetrics):
+    def __call__(self, *t):
+        self._report(t[1])
+        return t
+
+@spl.filter()
+class StageMetricsFilter(StageMetrics):
+    def __call__(self, *t):
+        self._report(t[1])
+        return True
+
+@spl.for_each()
+class StageMetricsForEach(StageMetrics):
+    def __call__(self, *t):
+        self._report(t[1])
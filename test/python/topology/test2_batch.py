@@ -0,0 +1,226 @@
+# coding=utf-8
+# Licensed Materials - Property of IBM
+# Copyright IBM Corp. 2018
+from future.builtins import *
+import unittest
+import sys
+import itertools
+import datetime
+import time
+import array
+
+from streamsx.topology.topology import *
+from streamsx.topology.tester import Tester
+from streamsx.topology.schema import StreamSchema, CommonSchema
+
+def _drop_odd(t):
+    return None if t % 2 else t * 10
+
+class _SlowSource(object):
+    def __init__(self, n):
+        self.n = n
+    def __call__(self):
+        for i in range(self.n):
+            time.sleep(0.05)
+            yield i
+
+class _SuppressOdd(object):
+    def __enter__(self):
+        pass
+    def __exit__(self, exc_type, exc_value, traceback):
+        return exc_type is ValueError
+    def __call__(self, t):
+        if t % 2:
+            raise ValueError('INTENTIONAL ERROR: odd value ' + str(t))
+        return t
+
+class TestBatchArgs(unittest.TestCase):
+    """ Validation of batching arguments.
+    """
+    def test_linger_without_size(self):
+        topo = Topology()
+        s = topo.source([1,2,3])
+        self.assertRaises(ValueError, s.map, lambda x : x, max_linger=1.0)
+
+    def test_bad_size(self):
+        topo = Topology()
+        s = topo.source([1,2,3])
+        self.assertRaises(ValueError, s.map, lambda x : x, batch_size=0)
+
+    def test_bad_linger(self):
+        topo = Topology()
+        s = topo.source([1,2,3])
+        self.assertRaises(ValueError, s.map, lambda x : x, batch_size=10, max_linger=0)
+
+    def test_params(self):
+        topo = Topology()
+        s = topo.source([1,2,3])
+        m = s.map(lambda x : x, batch_size=10, max_linger=datetime.timedelta(milliseconds=250))
+        params = m.oport.operator.params
+        self.assertEqual(10, params['batchSize'])
+        self.assertEqual(0.25, params['batchLinger'])
+
+    def test_filter_params(self):
+        topo = Topology()
+        s = topo.source([1,2,3])
+        f = s.filter(lambda x : x > 1, batch_size=5, max_linger=2)
+        params = f.oport.operator.params
+        self.assertEqual(5, params['batchSize'])
+        self.assertEqual(2.0, params['batchLinger'])
+        self.assertRaises(ValueError, s.filter, lambda x : x, max_linger=1.0)
+
+    def test_filter_batch_runtime(self):
+        import streamsx.topology.runtime as rt
+        mask = bytearray()
+        rt._filter_batch(lambda x : x % 3 == 0, [(i,) for i in range(7)], mask)
+        self.assertEqual(bytearray([1,0,0,1,0,0,1]), mask)
+
+    def test_filter_vectorized_params(self):
+        topo = Topology()
+        s = topo.source([1,2,3])
+        self.assertRaises(ValueError, s.filter, lambda b : b, vectorized=True)
+        f = s.filter(lambda b : b, batch_size=5, vectorized=True)
+        self.assertEqual(5, f.oport.operator.params['batchSize'])
+        self.assertRaises(TypeError, f.set_workers, 2)
+
+    def test_filter_vectorized_runtime(self):
+        import streamsx.topology.runtime as rt
+        batch = [(i,) for i in range(7)]
+        for sel in (lambda b : [x % 3 == 0 for x in b],
+                    lambda b : bytes(bytearray(x % 3 == 0 for x in b)),
+                    lambda b : array.array('i', [x % 3 == 0 for x in b])):
+            mask = bytearray()
+            rt._filter_batch(rt.object_in(rt._VectorizedFilter(sel)), batch, mask)
+            self.assertEqual(bytearray([1,0,0,1,0,0,1]), mask)
+
+        # A selection of bytes is copied as is, including
+        # a selection that is not contiguous.
+        for sel in (lambda b : bytearray([7,0,0,7,0,0,7]),
+                    lambda b : memoryview(bytearray([7,1,0,1,0,1,7,1,0,1,0,1,7]))[::2]):
+            mask = bytearray()
+            rt._filter_batch(rt.object_in(rt._VectorizedFilter(sel)), batch, mask)
+            self.assertEqual(bytearray([7,0,0,7,0,0,7]), mask)
+
+        mask = bytearray()
+        self.assertRaises(ValueError, rt._filter_batch,
+            rt.object_in(rt._VectorizedFilter(lambda b : [True])), batch, mask)
+
+        # Remainder of a batch after a suppressed exception.
+        mask = bytearray([0])
+        rt._filter_batch(rt.object_in(rt._VectorizedFilter(lambda b : b)), batch, mask)
+        self.assertEqual(bytearray(7), mask)
+
+class TestBatch(unittest.TestCase):
+    """ Test functional operators invoked with batches of tuples.
+    """
+    _multiprocess_can_split_ = True
+
+    def setUp(self):
+        Tester.setup_standalone(self)
+
+    def test_map_batch(self):
+        topo = Topology()
+        s = topo.source(range(1000))
+        s = s.map(_drop_odd, batch_size=64)
+
+        tester = Tester(topo)
+        tester.contents(s, [i*10 for i in range(0, 1000, 2)])
+        tester.test(self.test_ctxtype, self.test_config)
+
+    def test_map_batch_linger(self):
+        topo = Topology()
+        s = topo.source(_SlowSource(20))
+        s = s.map(lambda x : x + 1, batch_size=1000, max_linger=0.1)
+
+        tester = Tester(topo)
+        tester.contents(s, list(range(1, 21)))
+        tester.test(self.test_ctxtype, self.test_config)
+
+    def test_map_batch_string(self):
+        topo = Topology()
+        s = topo.source(['a', 'b', 'c', 'd'])
+        s = s.as_string()
+        s = s.map(lambda x : x.upper(), batch_size=3, schema=CommonSchema.String)
+
+        tester = Tester(topo)
+        tester.contents(s, ['A', 'B', 'C', 'D'])
+        tester.test(self.test_ctxtype, self.test_config)
+
+    def test_map_batch_structured(self):
+        topo = Topology()
+        s = topo.source(range(100))
+        s = s.map(lambda x : (x, 'V' + str(x)), schema='tuple<int32 a, rstring b>')
+        s = s.map(lambda t : {'a': t['a'] * 2, 'b': t['b']},
+            schema='tuple<int32 a, rstring b>', batch_size=7)
+        s = s.map(lambda t : (t['a'], t['b']))
+
+        tester = Tester(topo)
+        tester.contents(s, [(i*2, 'V' + str(i)) for i in range(100)])
+        tester.test(self.test_ctxtype, self.test_config)
+
+    def test_map_batch_suppress(self):
+        topo = Topology()
+        s = topo.source(range(50))
+        s = s.map(_SuppressOdd(), batch_size=8)
+
+        tester = Tester(topo)
+        tester.contents(s, list(range(0, 50, 2)))
+        tester.test(self.test_ctxtype, self.test_config)
+
+    def test_filter_batch(self):
+        topo = Topology()
+        s = topo.source(range(1000))
+        s = s.filter(lambda x : x % 3 == 0, batch_size=100)
+
+        tester = Tester(topo)
+        tester.contents(s, list(range(0, 1000, 3)))
+        tester.test(self.test_ctxtype, self.test_config)
+
+    def test_filter_batch_linger(self):
+        topo = Topology()
+        s = topo.source(_SlowSource(20))
+        s = s.filter(lambda x : x > 4, batch_size=1000, max_linger=0.1)
+
+        tester = Tester(topo)
+        tester.contents(s, list(range(5, 20)))
+        tester.test(self.test_ctxtype, self.test_config)
+
+    def test_filter_batch_structured(self):
+        topo = Topology()
+        s = topo.source(range(100))
+        s = s.map(lambda x : (x, 'V' + str(x)), schema='tuple<int32 a, rstring b>')
+        s = s.filter(lambda t : t['a'] % 2 == 1, batch_size=9)
+        s = s.map(lambda t : (t['a'], t['b']))
+
+        tester = Tester(topo)
+        tester.contents(s, [(i, 'V' + str(i)) for i in range(1, 100, 2)])
+        tester.test(self.test_ctxtype, self.test_config)
+
+    def test_filter_batch_suppress(self):
+        topo = Topology()
+        s = topo.source(range(50))
+        s = s.filter(_SuppressOdd(), batch_size=8)
+
+        tester = Tester(topo)
+        tester.contents(s, list(range(2, 50, 2)))
+        tester.test(self.test_ctxtype, self.test_config)
+
+    def test_filter_vectorized(self):
+        topo = Topology()
+        s = topo.source(range(1000))
+        s = s.filter(lambda b : [x % 3 == 0 for x in b], batch_size=100, vectorized=True)
+
+        tester = Tester(topo)
+        tester.contents(s, list(range(0, 1000, 3)))
+        tester.test(self.test_ctxtype, self.test_config)
+
+    def test_filter_vectorized_structured(self):
+        topo = Topology()
+        s = topo.source(range(100))
+        s = s.map(lambda x : (x, 'V' + str(x)), schema='tuple<int32 a, rstring b>')
+        s = s.filter(lambda b : bytes(bytearray(t['a'] % 2 for t in b)), batch_size=9, vectorized=True)
+        s = s.map(lambda t : (t['a'], t['b']))
+
+        tester = Tester(topo)
+        tester.contents(s, [(i, 'V' + str(i)) for i in range(1, 100, 2)])
+        tester.test(self.test_ctxtype, self.test_config)
@@ -3,6 +3,7 @@
 import unittest
 import sys
 import itertools
+import pickle
 import os
 import shutil
 
@@ -12,6 +13,15 @@ from streamsx.topology.context import ConfigParams
 import streamsx.spl.op as op
 import test_functions
 
+# Pickle protocol 5 is provided by Python 3.8 or the pickle5 package.
+try:
+    from pickle import PickleBuffer
+except ImportError:
+    try:
+        from pickle5 import PickleBuffer
+    except ImportError:
+        PickleBuffer = None
+
 class CheckForEach(object):
     def __init__(self):
         self.expected = ['ByRef', 3, 'a', 42]
@@ -22,6 +32,147 @@ class CheckForEach(object):
             raise AssertionError()
         self.count += 1
 
+def _large_value(i):
+    return {'i':i, 'data':list(range(i, i+1000))}
+
+def _check_large(v):
+    if v['data'] != list(range(v['i'], v['i']+1000)):
+        raise AssertionError()
+    return v['i']
+
+class _OutOfBand(object):
+    """Pickles its data out-of-band with protocol 5, like numpy arrays."""
+    def __init__(self, data):
+        self.data = data
+    def __reduce_ex__(self, protocol):
+        if protocol >= 5:
+            return _OutOfBand, (PickleBuffer(self.data),)
+        return _OutOfBand, (bytes(self.data),)
+    def __eq__(self, other):
+        return bytes(self.data) == bytes(other.data)
+
+def _out_of_band(i):
+    return [i, _OutOfBand(bytearray([i % 256]) * 5000), _OutOfBand(bytearray(b'small'))]
+
+def _check_out_of_band(v):
+    if v != _out_of_band(v[0]):
+        raise AssertionError()
+    return v[0]
+
+@unittest.skipIf(PickleBuffer is None, 'Pickle protocol 5 requires Python 3.8 or the pickle5 package')
+class TestPickle5(unittest.TestCase):
+    """ Test the layout of values with out-of-band buffers.
+    """
+    def test_round_trip(self):
+        import streamsx.topology.runtime as rt
+        v = _out_of_band(3)
+        pv = rt._pickle_dumps(v)
+        self.assertEqual(0x86, pv[0])
+        lv = rt._pickle_loads(memoryview(pv))
+        self.assertEqual(v, lv)
+        # Reconstructed from a writable copy, not the tuple's memory
+        self.assertFalse(lv[1].data.readonly)
+
+    def test_in_band(self):
+        import streamsx.topology.runtime as rt
+        v = [1, 'a', _OutOfBand(bytearray(b'small'))]
+        pv = rt._pickle_dumps(v)
+        self.assertEqual(0x80, pv[0])
+        self.assertEqual(v, rt._pickle_loads(memoryview(pv)))
+
+class TestSharedMemoryArgs(unittest.TestCase):
+    """ Validation of shared memory arguments.
+    """
+    def test_params(self):
+        topo = Topology()
+        s = topo.source(range(10)).set_shared_memory(4)
+        self.assertEqual(4, s.oport.operator.params['sharedMemory'])
+        m = s.map(_large_value).set_shared_memory(16)
+        self.assertEqual(16, m.oport.operator.params['sharedMemory'])
+        fm = s.flat_map(lambda x : [x]).set_shared_memory(1)
+        self.assertEqual(1, fm.oport.operator.params['sharedMemory'])
+
+    def test_bad_size(self):
+        topo = Topology()
+        s = topo.source(range(10))
+        self.assertRaises(ValueError, s.set_shared_memory, 0)
+
+    def test_bad_stream(self):
+        topo = Topology()
+        s = topo.source(range(10))
+        self.assertRaises(TypeError, s.filter(lambda x : True).set_shared_memory, 4)
+        self.assertRaises(TypeError, s.as_string().set_shared_memory, 4)
+        self.assertRaises(TypeError, s.map(lambda x : (x,), schema='tuple<int32 x>').set_shared_memory, 4)
+
+class TestCodecArgs(unittest.TestCase):
+    """ Validation of codec arguments.
+    """
+    def test_params(self):
+        topo = Topology()
+        s = topo.source(range(10)).set_codec('msgpack')
+        self.assertEqual('msgpack', s.oport.operator.params['pyCodec'])
+        m = s.map(lambda x : x).set_codec('msgpack')
+        self.assertEqual('msgpack', m.oport.operator.params['pyCodec'])
+        m.set_codec('pickle')
+        self.assertNotIn('pyCodec', m.oport.operator.params)
+        fm = s.flat_map(lambda x : [x]).set_codec('msgpack')
+        self.assertEqual('msgpack', fm.oport.operator.params['pyCodec'])
+
+    def test_bad_codec(self):
+        topo = Topology()
+        s = topo.source(range(10))
+        self.assertRaises(ValueError, s.set_codec, 'json')
+        self.assertRaises(ValueError, s.set_codec, None)
+
+    def test_bad_stream(self):
+        topo = Topology()
+        s = topo.source(range(10))
+        self.assertRaises(TypeError, s.filter(lambda x : True).set_codec, 'msgpack')
+        self.assertRaises(TypeError, s.as_string().set_codec, 'msgpack')
+
+def _codec_value(i):
+    return {'i': i, 'f': i / 2.0, 's': u'v' + str(i), 'b': b'\x00' * i,
+        'l': [None, True, False, -i, 2**40 + i], 't': (i, (u'x',)),
+        'o': CheckForEach() if i % 10 == 0 else None}
+
+def _check_codec(v):
+    i = v['i']
+    expect = _codec_value(i)
+    del expect['o']
+    if v['o'] is not None:
+        if i % 10 != 0 or not isinstance(v['o'], CheckForEach):
+            raise ValueError("Codec fallback mismatch: " + str(v))
+    del v['o']
+    if v != expect or not isinstance(v['t'], tuple) or not isinstance(v['t'][1], tuple):
+        raise ValueError("Codec mismatch: " + str(v) + " " + str(expect))
+    return i
+
+def _nest(n, kind, leaf):
+    v = leaf
+    for _ in range(n):
+        v = [v] if kind == 'l' else (v,) if kind == 't' else {'k': v}
+    return v
+
+# msgpack codec limit is 256 nested containers, i = 0,1,2 are at
+# the limit, i = 3,4 are one deeper so they are pickled.
+def _deep_value(i):
+    if i == 0:
+        return _nest(256, 'l', i)
+    if i == 1:
+        return _nest(256, 't', i)
+    if i == 2:
+        return _nest(128, 't', _nest(128, 'd', i))
+    return _nest(257, 'l' if i == 3 else 't', i)
+
+def _check_deep(v):
+    depth = 0
+    while isinstance(v, (list, tuple, dict)):
+        v = v['k'] if isinstance(v, dict) else v[0]
+        depth += 1
+    if depth != (256 if v < 3 else 257):
+        raise ValueError("Codec depth mismatch: " + str(depth) + " for " + str(v))
+    return v
+
 class TestByRef(unittest.TestCase):
     _multiprocess_can_split_ = True
 
@@ -39,6 +190,51 @@ class TestByRef(unittest.TestCase):
         tester.contents(s, ['ByRef', 3, 'a', 42])
         tester.test(self.test_ctxtype, self.test_config)
 
+    def test_SharedMemory(self):
+        topo = Topology()
+        s = topo.source(range(200))
+        s = s.map(_large_value).set_shared_memory(1)
+        s = s.isolate()
+        s = s.map(_check_large)
+
+        tester = Tester(topo)
+        tester.contents(s, list(range(200)))
+        tester.test(self.test_ctxtype, self.test_config)
+
+    @unittest.skipIf(PickleBuffer is None, 'Pickle protocol 5 requires Python 3.8 or the pickle5 package')
+    def test_Pickle5(self):
+        topo = Topology()
+        s = topo.source(range(20))
+        s = s.map(_out_of_band)
+        s = s.isolate()
+        s = s.map(_check_out_of_band)
+
+        tester = Tester(topo)
+        tester.contents(s, list(range(20)))
+        tester.test(self.test_ctxtype, self.test_config)
+
+    def test_Codec(self):
+        topo = Topology()
+        s = topo.source(range(50))
+        s = s.map(_codec_value).set_codec('msgpack')
+        s = s.isolate()
+        s = s.map(_check_codec)
+
+        tester = Tester(topo)
+        tester.contents(s, list(range(50)))
+        tester.test(self.test_ctxtype, self.test_config)
+
+    def test_CodecDepth(self):
+        topo = Topology()
+        s = topo.source(range(5))
+        s = s.map(_deep_value).set_codec('msgpack')
+        s = s.isolate()
+        s = s.map(_check_deep)
+
+        tester = Tester(topo)
+        tester.contents(s, list(range(5)))
+        tester.test(self.test_ctxtype, self.test_config)
+
     def test_NotByRef(self):
         topo = Topology()
         s = topo.source(['ByRef', 3, list(('a', 42))])
@@ -52,3 +248,7 @@ class TestByRef(unittest.TestCase):
         tester = Tester(topo)
         tester.contents(s, ['ByRef', 3, 'a', 42])
         tester.test(self.test_ctxtype, self.test_config)
+
+class TestDistributedByRef(TestByRef):
+    def setUp(self):
+        Tester.setup_distributed(self)
@@ -0,0 +1,49 @@
+# Licensed Materials - Property of IBM
+# Copyright IBM Corp. 2018
+import unittest
+import os
+
+from streamsx.topology.topology import *
+from streamsx.topology.tester import Tester
+import streamsx.ec as ec
+
+class GILMetrics(object):
+    """ Return each value with the values of the operator's
+    GIL metrics. A metric that was not created by the
+    operator would be created here with a value of zero.
+    """
+    def __enter__(self):
+        self.wait = ec.CustomMetric(self, 'nGILWaitNanos', kind=ec.MetricKind.Counter)
+        self.hold = ec.CustomMetric(self, 'nGILHoldNanos', kind=ec.MetricKind.Counter)
+
+    def __exit__(self, exc_type, exc_value, traceback):
+        pass
+
+    def __call__(self, v):
+        return v, self.wait.value, self.hold.value
+
+class TestGILMetrics(unittest.TestCase):
+    """ Test the GIL metrics enabled by STREAMSX_PYTHON_GIL_METRICS.
+    """
+    _multiprocess_can_split_ = False
+
+    def setUp(self):
+        Tester.setup_standalone(self)
+        os.environ['STREAMSX_PYTHON_GIL_METRICS'] = '1'
+
+    def tearDown(self):
+        del os.environ['STREAMSX_PYTHON_GIL_METRICS']
+
+    def test_gil_metrics(self):
+        # Metrics are published every 64 samples of
+        # one in 16 acquisitions of the GIL.
+        n = 5000
+        topo = Topology()
+        s = topo.source(range(n))
+        s = s.map(GILMetrics())
+        s = s.filter(lambda v : v[0] == n - 1)
+        s = s.map(lambda v : (v[1] > 0, v[2] > 0))
+
+        tester = Tester(topo)
+        tester.contents(s, [(True, True)])
+        tester.test(self.test_ctxtype, self.test_config)
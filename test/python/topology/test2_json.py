@@ -44,6 +44,30 @@ class TestJson(unittest.TestCase):
         tester.contents(s, ['JSON!', 3, ['a', 42]])
         tester.test(self.test_ctxtype, self.test_config)
 
+    def test_json_round_trip(self):
+        """ Test JSON serialized and deserialized by the
+            operators matches the json module.
+            An integer outside 64 bits is in its own document
+            as that document is parsed by the json module.
+        """
+        values = [
+          {'s': u'q"b\\s\n\x01\x7f/\u00e9\u4e2d\U0001f600', 'i': [0, -1, 2**63-1, -2**63],
+           'f': [0.1, -0.0, 1e16, 1e15, 5e-324, 1.5e-7, 1.7976931348623157e308],
+           'n': None, 'b': [True, False], 't': (1, u'x'), 'e': {}, 'l': [[]]},
+          {'big': [2**63, -2**63-1, 2**70]},
+          {'payload': 7}]
+        topo = Topology()
+        s = topo.source(values)
+        s = s.as_json()
+        f = op.Map('spl.relational::Functor', s, schema='tuple<rstring string>')
+        f.string = f.output(f.attribute('jsonString'))
+        r = s.map(lambda x : x)
+
+        tester = Tester(topo)
+        tester.contents(f.stream, [json.dumps(v, ensure_ascii=False) for v in values])
+        tester.contents(r, [json.loads(json.dumps(v)) for v in values])
+        tester.test(self.test_ctxtype, self.test_config)
+
     def test_as_string(self):
         topo = Topology()
         s = topo.source(['String!', 3, 42.0])
@@ -0,0 +1,103 @@
+# coding=utf-8
+# Licensed Materials - Property of IBM
+# Copyright IBM Corp. 2018
+from __future__ import print_function
+import unittest
+import sys
+import os
+import time
+import itertools
+import tempfile
+
+from streamsx.topology.topology import *
+from streamsx.topology.tester import Tester
+
+"""
+Performance of converting Python strings returned
+by callables to SPL rstring attributes.
+
+Run with STREAMSX_TOPOLOGY_PERF set. Each string length
+and mix of characters is run with the direct conversion
+and with Python's conversion (STREAMSX_PYTHON_DIRECT_STRINGS=0),
+the time per tuple of both and the speedup of the direct
+conversion are written to stderr.
+"""
+
+PERF_OK = 'STREAMSX_TOPOLOGY_PERF' in os.environ
+
+# Non-ASCII character used for each mix
+_MIXES = {'ascii':u'a', 'latin1':u'é', 'bmp':u'中', 'astral':u'😀'}
+
+class StringTimer(object):
+    def __init__(self, n, path):
+        self.n = n
+        self.path = path
+        self.count = 0
+        self.ts = None
+
+    def __call__(self, t):
+        if self.ts is None:
+            self.ts = time.time()
+            return
+        self.count += 1
+        if self.count == self.n - 1:
+            ns = (time.time() - self.ts) * 1e9 / self.count
+            with open(self.path, 'w') as f:
+                f.write(str(ns))
+
+def make_string(mix, length):
+    c = _MIXES[mix]
+    return u''.join(c if i % 4 == 0 else u'b' for i in range(length))
+
+@unittest.skipUnless(PERF_OK, "STREAMSX_TOPOLOGY_PERF not set")
+class TestPerfStrings(unittest.TestCase):
+    _multiprocess_can_split_ = True
+
+    def setUp(self):
+        Tester.setup_standalone(self)
+
+    def _time(self, mix, length, direct):
+        n = 500000
+        v = make_string(mix, length)
+        fd, path = tempfile.mkstemp()
+        os.close(fd)
+        topo = Topology()
+        s = topo.source(lambda : itertools.repeat(v, n))
+        s = s.map(lambda x : (x,), schema='tuple<rstring s>')
+        s.for_each(StringTimer(n, path))
+
+        tester = Tester(topo)
+        tester.tuple_count(s, n)
+        if not direct:
+            os.environ['STREAMSX_PYTHON_DIRECT_STRINGS'] = '0'
+        try:
+            tester.test(self.test_ctxtype, self.test_config)
+        finally:
+            os.environ.pop('STREAMSX_PYTHON_DIRECT_STRINGS', None)
+        with open(path) as f:
+            ns = float(f.read())
+        os.remove(path)
+        return ns
+
+    def _run(self, mix, length):
+        direct = self._time(mix, length, True)
+        python = self._time(mix, length, False)
+        print(mix, length, 'direct %.1f ns/tuple' % direct,
+            'python %.1f ns/tuple' % python,
+            'speedup %.2fx' % (python / direct), file=sys.stderr)
+
+    def test_ascii(self):
+        for length in [4, 16, 64, 256, 4096]:
+            self._run('ascii', length)
+
+    def test_latin1(self):
+        for length in [4, 16, 64, 256, 4096]:
+            self._run('latin1', length)
+
+    def test_bmp(self):
+        for length in [4, 16, 64, 256, 4096]:
+            self._run('bmp', length)
+
+    def test_astral(self):
+        for length in [4, 16, 64, 256, 4096]:
+            self._run('astral', length)
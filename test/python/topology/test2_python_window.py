@@ -13,6 +13,14 @@ def _delay(x):
     time.sleep(0.2)
     return x
 
+def _idle_source():
+    # Partition False is idle for three seconds before 2 arrives.
+    yield 0
+    yield 1
+    time.sleep(3)
+    yield 2
+    yield 3
+
 class _BatchTimeCheck(object):
     def __init__(self):
         self.expect = 0 
@@ -110,10 +118,161 @@ class TupleTimespanCheck(object):
         mark = time.time() - self.span
         return all([mark < item[1] for item in items])
             
+class _Sum(object):
+    """Accumulator maintaining the sum of a window."""
+    def __init__(self):
+        self.total = 0
+    def add(self, v):
+        self.total += v
+    def remove(self, v):
+        self.total -= v
+    def result(self):
+        return self.total
+
+class _NoRemove(object):
+    def add(self, v):
+        pass
+    def result(self):
+        return None
+
 # Given a value, a tolerance, and the expected value, return true iff the value is
 # within the margin of error.
 within_tolerance = lambda val, tol, exp: val < exp + (tol*exp) and val > exp - (tol*exp)
 
+def _pickled(s):
+    """Pass a Python stream through an SPL operator so that
+    values arrive at the window pickled rather than by reference."""
+    return op.Map('spl.relational::Functor', s).stream
+
+class _Finalized(object):
+    """Value counting the instances finalized in this
+    process after being passed to _aggregate_finalized."""
+    count = 0
+    def __init__(self, v):
+        self.v = v
+        self.aggregated = False
+    def __del__(self):
+        if self.aggregated:
+            _Finalized.count += 1
+
+def _aggregate_finalized(items):
+    for i in items:
+        i.aggregated = True
+    return _Finalized.count, [i.v for i in items]
+
+class _Depickled(object):
+    """Value counting the instances depickled in this process."""
+    count = 0
+    def __init__(self, v):
+        self.v = v
+    def __setstate__(self, state):
+        self.__dict__.update(state)
+        _Depickled.count += 1
+
+class TestAccumulateArgs(unittest.TestCase):
+    """ Validation of accumulate arguments.
+    """
+    def test_params(self):
+        topo = Topology()
+        s = topo.source(range(10))
+        r = s.last(3).trigger(1).accumulate(_Sum())
+        self.assertTrue(r.oport.operator.params['incremental'])
+
+    def test_bad_accumulator(self):
+        topo = Topology()
+        s = topo.source(range(10))
+        self.assertRaises(TypeError, s.last(3).accumulate, _NoRemove())
+        self.assertRaises(TypeError, s.last(3).accumulate, lambda x : x)
+
+class TestColumnsArgs(unittest.TestCase):
+    """ Validation of aggregate by columns arguments.
+    """
+    def test_params(self):
+        topo = Topology()
+        s = topo.source(range(10)).map(lambda x : (x,), schema='tuple<int32 a>')
+        r = s.last(3).aggregate(lambda c : sum(c[0]), columns=True)
+        self.assertTrue(r.oport.operator.params['columns'])
+        r = s.last(3).aggregate(lambda items : len(items))
+        self.assertNotIn('columns', r.oport.operator.params)
+
+    def test_bad_stream(self):
+        topo = Topology()
+        s = topo.source(range(10))
+        self.assertRaises(TypeError, s.last(3).aggregate, lambda c : c, columns=True)
+        v = s.map(lambda x : (x,), schema=StreamSchema('tuple<int32 a>').as_view())
+        self.assertRaises(TypeError, v.last(3).aggregate, lambda c : c, columns=True)
+
+class TestLazyArgs(unittest.TestCase):
+    """ Validation of lazy depickling arguments.
+    """
+    def test_params(self):
+        topo = Topology()
+        s = topo.source(range(10))
+        r = s.last(3).aggregate(lambda items : len(items), lazy=True)
+        self.assertTrue(r.oport.operator.params['lazy'])
+
+    def test_bad_stream(self):
+        topo = Topology()
+        s = topo.source(range(10))
+        self.assertRaises(TypeError, s.as_string().last(3).aggregate, len, lazy=True)
+        st = s.map(lambda x : (x,), schema='tuple<int32 a>')
+        self.assertRaises(TypeError, st.last(3).aggregate, len, lazy=True)
+
+class TestPartitionArgs(unittest.TestCase):
+    """ Validation of partitioned window arguments.
+    """
+    def test_params(self):
+        topo = Topology()
+        s = topo.source(range(10))
+        r = s.last(3).partition(lambda x : x % 2).aggregate(len)
+        self.assertTrue(r.oport.operator.params['pyPartitionKey'])
+        st = s.map(lambda x : (x,), schema='tuple<int32 a>')
+        r = st.last(3).partition('a').aggregate(len)
+        self.assertEqual('a', r.oport.operator.params['partitionBy'])
+
+    def test_config(self):
+        topo = Topology()
+        s = topo.source(range(10))
+        w = s.last(3).partition(str, idle=datetime.timedelta(minutes=2))
+        self.assertTrue(w._config['partitioned'])
+        self.assertEqual(120.0, w._config['partitionAge'])
+        w = s.last(3).partition(str, max_partitions=100)
+        self.assertEqual(100, w._config['partitionCount'])
+        self.assertNotIn('partitionAge', w._config)
+        w = w.trigger(2)
+        self.assertTrue(w._config['partitioned'])
+        self.assertEqual(100, w._config['partitionCount'])
+        self.assertIs(str, w._key)
+
+    def test_bad_args(self):
+        topo = Topology()
+        s = topo.source(range(10))
+        w = s.last(3)
+        self.assertRaises(TypeError, w.partition, 3)
+        self.assertRaises(TypeError, w.partition, 'a')
+        self.assertRaises(TypeError, w.partition, str, idle=3)
+        self.assertRaises(ValueError, w.partition, str, max_partitions=0)
+        self.assertRaises(ValueError, w.partition, str, idle=datetime.timedelta(seconds=1), max_partitions=1)
+        self.assertRaises(TypeError, w.partition(str).accumulate, _Sum())
+        self.assertRaises(TypeError, w.partition(str).aggregate, len, lazy=True)
+
+    def test_key_runtime(self):
+        import streamsx.topology.runtime as rt
+        class Wrapper(object):
+            def __init__(self, key):
+                self._callable = rt._PartitionedAggregate(len, key)
+        pk = rt._partition_key(Wrapper(lambda v : v))
+        # Keys that compare equal are the same partition.
+        self.assertEqual(pk(1), pk(1.0))
+        self.assertEqual(pk(1), pk(True))
+        self.assertEqual(pk(0), pk(-0.0))
+        self.assertEqual(pk(('a', 2)), pk(('a', 2.0)))
+        self.assertNotEqual(pk(1), pk('1'))
+        self.assertNotEqual(pk(1.5), pk(1))
+        self.assertNotEqual(pk(('a,b',)), pk(('a','b')))
+        for key in (None, object(), [1], {'a': 1}, ('a', None)):
+            self.assertRaises(TypeError, pk, key)
+
 class TestPythonWindowing(unittest.TestCase):
     _multiprocess_can_split_ = True
 
@@ -309,3 +468,131 @@ class TestPythonWindowing(unittest.TestCase):
         tester.run_for((50*0.2) + 20)
         tester.tuple_check(r, _BatchTimeCheck())
         tester.test(self.test_ctxtype, self.test_config)
+
+    def test_batch_release(self):
+        # Each batch is released when it is flushed, so the
+        # previous batches have been finalized when a batch
+        # is aggregated.
+        topo = Topology()
+        s = topo.source(lambda : (_Finalized(i) for i in range(12)))
+        r = s.batch(4).aggregate(_aggregate_finalized)
+
+        tester = Tester(topo)
+        tester.contents(r, [(0,[0,1,2,3]), (4,[4,5,6,7]), (8,[8,9,10,11])])
+        tester.test(self.test_ctxtype, self.test_config)
+
+    def test_accumulate_count(self):
+        topo = Topology()
+        s = topo.source(lambda : range(8))
+        r = s.last(3).trigger(1).accumulate(_Sum())
+
+        tester = Tester(topo)
+        tester.contents(r, [0,1,3,6,9,12,15,18])
+        tester.test(self.test_ctxtype, self.test_config)
+
+    def test_accumulate_batch(self):
+        topo = Topology()
+        s = topo.source(lambda : range(20))
+        r = s.batch(4).accumulate(_Sum())
+
+        tester = Tester(topo)
+        tester.contents(r, [0+1+2+3,4+5+6+7,8+9+10+11,12+13+14+15,16+17+18+19])
+        tester.tuple_count(r, 5)
+        tester.test(self.test_ctxtype, self.test_config)
+
+    def test_columns_dict(self):
+        topo = Topology()
+        s = topo.source(lambda : range(8))
+        s = s.map(lambda x : {'a': x, 'b': float(x)/2.0, 's': str(x)}, schema='tuple<int64 a, float64 b, rstring s>')
+        r = s.last(3).trigger(4).aggregate(lambda c : (sum(c['a']), sum(c['b']), ''.join(c['s'])), columns=True)
+
+        tester = Tester(topo)
+        tester.contents(r, [(6, 3.0, '123'), (18, 9.0, '567')])
+        tester.test(self.test_ctxtype, self.test_config)
+
+    def test_columns_tuple(self):
+        topo = Topology()
+        s = topo.source(lambda : range(12))
+        s = s.map(lambda x : (x, x*x), schema='tuple<int32 a, int32 b>')
+        r = s.batch(4).aggregate(lambda c : (list(c[0]), sum(c[1])), columns=True)
+
+        tester = Tester(topo)
+        tester.contents(r, [([0,1,2,3], 14), ([4,5,6,7], 126), ([8,9,10,11], 366)])
+        tester.test(self.test_ctxtype, self.test_config)
+
+    def test_lazy_count(self):
+        topo = Topology()
+        s = _pickled(topo.source(lambda : [{'v': i} for i in range(20)]))
+        r = s.last(3).trigger(5).aggregate(lambda items : [i['v'] for i in items], lazy=True)
+
+        tester = Tester(topo)
+        tester.contents(r, [[2,3,4], [7,8,9], [12,13,14], [17,18,19]])
+        tester.test(self.test_ctxtype, self.test_config)
+
+    def test_lazy_batch(self):
+        topo = Topology()
+        s = _pickled(topo.source(lambda : range(10)))
+        r = s.batch(4).aggregate(lambda items : sum(items), lazy=True)
+
+        tester = Tester(topo)
+        tester.contents(r, [0+1+2+3, 4+5+6+7, 8+9])
+        tester.test(self.test_ctxtype, self.test_config)
+
+    def test_lazy_evicted(self):
+        # Only the values in the window when it triggers are
+        # depickled, each once, values evicted before are not.
+        topo = Topology()
+        s = _pickled(topo.source(lambda : [_Depickled(i) for i in range(20)]))
+        r = s.last(3).trigger(5).aggregate(lambda items : (_Depickled.count, [i.v for i in items]), lazy=True)
+
+        tester = Tester(topo)
+        tester.contents(r, [(3,[2,3,4]), (6,[7,8,9]), (9,[12,13,14]), (12,[17,18,19])])
+        tester.test(self.test_ctxtype, self.test_config)
+
+    def test_partition_key(self):
+        topo = Topology()
+        s = topo.source(lambda : range(16))
+        r = s.batch(4).partition(lambda x : x % 2).aggregate(sum)
+
+        tester = Tester(topo)
+        tester.contents(r, [0+2+4+6, 1+3+5+7, 8+10+12+14, 9+11+13+15])
+        tester.test(self.test_ctxtype, self.test_config)
+
+    def test_partition_attribute(self):
+        topo = Topology()
+        s = topo.source(lambda : range(8))
+        s = s.map(lambda x : {'a': x, 'k': 'even' if x % 2 == 0 else 'odd'}, schema='tuple<int32 a, rstring k>')
+        r = s.batch(2).partition('k').aggregate(lambda items : sum(t['a'] for t in items))
+
+        tester = Tester(topo)
+        tester.contents(r, [0+2, 1+3, 4+6, 5+7])
+        tester.test(self.test_ctxtype, self.test_config)
+
+    def test_partition_equal_keys(self):
+        topo = Topology()
+        s = topo.source(lambda : range(6))
+        r = s.batch(3).partition(lambda x : (1, 1.0, True)[x % 3]).aggregate(lambda items : items)
+
+        tester = Tester(topo)
+        tester.contents(r, [[0,1,2], [3,4,5]])
+        tester.test(self.test_ctxtype, self.test_config)
+
+    def test_partition_max_partitions(self):
+        # Partitions 0,1,2 then 0 again, partition 0 is evicted
+        # when partition 2 is created so 6 starts a new partition.
+        topo = Topology()
+        s = topo.source(lambda : range(8))
+        r = s.last(10).partition(lambda x : x // 2 % 3, max_partitions=2).trigger(1).aggregate(lambda items : items)
+
+        tester = Tester(topo)
+        tester.contents(r, [[0], [0,1], [2], [2,3], [4], [4,5], [6], [6,7]])
+        tester.test(self.test_ctxtype, self.test_config)
+
+    def test_partition_idle(self):
+        topo = Topology()
+        s = topo.source(_idle_source)
+        r = s.last(10).partition(lambda x : x == 2, idle=datetime.timedelta(seconds=1)).trigger(1).aggregate(lambda items : items)
+
+        tester = Tester(topo)
+        tester.contents(r, [[0], [0,1], [2], [3]])
+        tester.test(self.test_ctxtype, self.test_config)
@@ -0,0 +1,158 @@
+# Licensed Materials - Property of IBM
+# Copyright IBM Corp. 2018
+import unittest
+import sys
+import pickle
+
+from streamsx.topology.topology import *
+from streamsx.topology.schema import CommonSchema, StreamSchema
+from streamsx.topology.tester import Tester
+
+"""
+Test that structured schemas can be passed into Python functions as views.
+"""
+
+def _check_raises(t, key, exc):
+    try:
+        t[key]
+    except exc:
+        return
+    raise ValueError("Expected " + exc.__name__ + " for " + repr(key) + ":" + str(t))
+
+def check_view(t):
+    if isinstance(t, (dict,tuple)):
+        raise ValueError("Expected a view:" + str(t) + " >> type:" + str(type(t)))
+    if len(t) != 3:
+        raise ValueError("Incorrect length:" + str(t))
+    if list(t) != ['x', 'msg', 'extra'] or t.keys() != ['x', 'msg', 'extra']:
+        raise ValueError("Incorrect keys:" + str(t))
+    if t['x'] != t[0] or t.x != t[0] or t[-1] != t['extra']:
+        raise ValueError("Inconsistent access:" + str(t))
+    if t.msg != str(t.x*2) + "Hi!":
+        raise ValueError("Incorrect value:" + str(t))
+    if 'msg' not in t or 'y' in t or t.get('y', 7) != 7:
+        raise ValueError("Incorrect membership:" + str(t))
+    _check_raises(t, 'y', KeyError)
+    _check_raises(t, 3, IndexError)
+    _check_raises(t, 2**70, OverflowError)
+    # As with a dict a bool is not a position.
+    _check_raises(t, True, KeyError)
+    if t._asdict() != {'x':t.x, 'msg':t.msg, 'extra':t.extra}:
+        raise ValueError("Incorrect dict:" + str(t))
+
+def check_view_filter(t):
+    check_view(t)
+    return t.x != 2
+
+def check_view_hash(t):
+    check_view(t)
+    return t.x
+
+def check_view_map(t):
+    check_view(t)
+    return (t.x*7, t.msg + "-Map")
+
+class ViewAttributes(object):
+    """Only access a single attribute of the view."""
+    def __call__(self, t):
+        return t['x'] * 3
+
+class SumViews(object):
+    """Retains views in the window."""
+    def __call__(self, items):
+        return sum(t['x'] for t in items), [t['msg'] for t in items]
+
+class TestSchemaView(unittest.TestCase):
+    """ Test invocations handling of SPL schemas as views in Python ops.
+    """
+    _multiprocess_can_split_ = True
+
+    def setUp(self):
+        Tester.setup_standalone(self)
+
+    def _create_stream(self, topo):
+        s = topo.source([1,2,3])
+        schema = StreamSchema('tuple<int32 x, rstring msg, float64 extra>')
+        return s.map(lambda x : (x, str(x*2) + "Hi!", x/2.0), schema=schema.as_view())
+
+    def test_style(self):
+        schema = StreamSchema('tuple<int32 x, rstring msg>')
+        self.assertIsNot(schema.style, schema.as_view().style)
+        self.assertIs(schema.as_view().style, schema.as_tuple().as_view().style)
+        self.assertIs(schema.style, schema.as_view().as_dict().style)
+        self.assertIs(CommonSchema.Python.value, CommonSchema.Python.value.as_view())
+
+    def test_as_view_for_each(self):
+        topo = Topology()
+        st = self._create_stream(topo)
+        st.for_each(check_view)
+
+        tester = Tester(topo)
+        tester.tuple_count(st, 3)
+        tester.test(self.test_ctxtype, self.test_config)
+
+    def test_as_view_map(self):
+        topo = Topology()
+        s = self._create_stream(topo)
+        st = s.map(check_view_map)
+
+        tester = Tester(topo)
+        tester.contents(st, [(7,'2Hi!-Map'), (14,'4Hi!-Map'), (21,'6Hi!-Map')])
+        tester.test(self.test_ctxtype, self.test_config)
+
+    def test_as_view_map_single_attribute(self):
+        topo = Topology()
+        s = self._create_stream(topo)
+        st = s.map(ViewAttributes())
+
+        tester = Tester(topo)
+        tester.contents(st, [3, 6, 9])
+        tester.test(self.test_ctxtype, self.test_config)
+
+    def test_as_view_map_pickle(self):
+        topo = Topology()
+        s = self._create_stream(topo)
+        st = s.map(lambda t : t)
+        st = st.map(lambda t : (type(t) is dict, t['x'], t['extra']))
+
+        tester = Tester(topo)
+        tester.contents(st, [(True, 1, 0.5), (True, 2, 1.0), (True, 3, 1.5)])
+        tester.test(self.test_ctxtype, self.test_config)
+
+    def test_as_view_filter(self):
+        topo = Topology()
+        s = self._create_stream(topo)
+        s = s.filter(check_view_filter)
+
+        tester = Tester(topo)
+        tester.tuple_count(s, 2)
+        tester.test(self.test_ctxtype, self.test_config)
+
+    def test_as_view_flat_map(self):
+        topo = Topology()
+        s = self._create_stream(topo)
+        st = s.flat_map(lambda t : [check_view_map(t)])
+
+        tester = Tester(topo)
+        tester.contents(st, [(7,'2Hi!-Map'), (14,'4Hi!-Map'), (21,'6Hi!-Map')])
+        tester.test(self.test_ctxtype, self.test_config)
+
+    def test_as_view_hash(self):
+        topo = Topology()
+        s = self._create_stream(topo)
+        s = s.parallel(width=2, routing=Routing.HASH_PARTITIONED, func=check_view_hash)
+        s = s.map(check_view_map)
+        s = s.end_parallel()
+
+        tester = Tester(topo)
+        tester.contents(s, [(7,'2Hi!-Map'), (14,'4Hi!-Map'), (21,'6Hi!-Map')], ordered=False)
+        tester.test(self.test_ctxtype, self.test_config)
+
+    def test_as_view_aggregate(self):
+        topo = Topology()
+        s = self._create_stream(topo)
+        s = s.last(3).trigger(3).aggregate(SumViews())
+
+        tester = Tester(topo)
+        tester.contents(s, [(6, ['2Hi!', '4Hi!', '6Hi!'])])
+        tester.test(self.test_ctxtype, self.test_config)
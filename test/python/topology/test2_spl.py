@@ -200,6 +200,28 @@ class TestSPL(unittest.TestCase):
         tester.contents(as_ts, [ts1.tuple(), ts2.tuple()])
         tester.test(self.test_ctxtype, self.test_config)
 
+    def test_timestamp_round_trip(self):
+        """ Test timestamps passed from SPL to Python
+            and back to SPL across multiple operators.
+        """
+        ts_schema = StreamSchema('tuple<timestamp ts, timestamp ts2>')
+
+        tss = [Timestamp(133001, 302245576, 56), Timestamp(0, 0),
+               Timestamp(-4, 999999999, -7), Timestamp(23543463, 876265298)]
+
+        topo = Topology()
+        s = topo.source(tss)
+        s = s.map(lambda x : (x, x), schema=ts_schema)
+        s = s.map(lambda t : (t['ts2'], t['ts']), schema=ts_schema)
+        s = s.filter(lambda t : type(t['ts']) is Timestamp and t['ts'] == t['ts2'])
+        # Timestamps are pickled for a Python object stream.
+        s = s.map(lambda t : t['ts'])
+        s = s.map(lambda ts : (type(ts) is Timestamp, ts.seconds, ts.nanoseconds, ts.machine_id))
+
+        tester = Tester(topo)
+        tester.contents(s, [(True,) + ts.tuple() for ts in tss])
+        tester.test(self.test_ctxtype, self.test_config)
+
     def test_custom_literal(self):
         schema = StreamSchema('tuple<int32 a, rstring b>')
         topo = Topology()
@@ -311,6 +333,62 @@ class TestConversion(unittest.TestCase):
                 tester.contents(c, expected)
                 tester.test(self.test_ctxtype, self.test_config)
 
+    def test_decimal_round_trip(self):
+        """ Test decimal values passed from SPL to Python
+            and back to SPL are unchanged.
+
+            The string of each Python value, which includes its
+            coefficient and exponent, must be the value formatted
+            in scientific notation with the type's precision,
+            as the conversion has always formatted decimals.
+        """
+        data = {
+          'decimal32': (7, ['9.999999', '-1234567', '1E-95', '9.999999E+96', '-0.000001']),
+          'decimal64': (16, ['9.999999999999999', '-1234567890123456', '1E-383', '9.999999999999999E+384', '0.1']),
+          'decimal128': (34, ['9.999999999999999999999999999999999', '-1234567890123456789012345678901234', '1E-6143', '9.999999999999999999999999999999999E+6144', '0.1']),
+        }
+        for dt, (digits, values) in data.items():
+            topo = Topology()
+            schema = StreamSchema('tuple<' + dt + ' a>')
+            s = topo.source([decimal.Decimal(v) for v in values])
+            c = s.map(lambda x : (x,), schema=schema)
+            # Second hop converts the Python value from the first hop
+            c2 = c.map(lambda t : (t['a'],), schema=schema)
+            r = c.map(lambda t : str(t['a']))
+            r2 = c2.map(lambda t : str(t['a']))
+
+            fmt = '.' + str(digits - 1) + 'e'
+            expected = [str(decimal.Decimal(format(decimal.Decimal(v), fmt))) for v in values]
+            tester = Tester(topo)
+            tester.contents(r, expected)
+            tester.contents(r2, expected)
+            tester.test(self.test_ctxtype, self.test_config)
+
+    @unittest.skipIf(sys.version_info.major == 2, "memoryview requires Python 3")
+    def test_numeric_list_buffers(self):
+        """ Test numeric lists set from objects supporting
+            the buffer protocol and passed as memoryviews.
+        """
+        import array
+        schema = StreamSchema('tuple<list<float64> f, list<int32> i, list<uint8> u, list<rstring> s>')
+        topo = Topology()
+        s = topo.source([3, 0, 5])
+        c = s.map(lambda n : (array.array('d', [x/2.0 for x in range(n)]), array.array('i', range(-n, 0)), bytearray(range(n)), ['a'] * n), schema=schema.with_buffers())
+        types = c.map(lambda t : (type(t['f']).__name__, t['f'].format, t['i'].format, type(t['s']).__name__))
+        # Returning the memoryviews sets the lists from them
+        b = c.map(lambda t : t, schema=schema)
+        v = b.map(lambda t : (t['f'], t['i'], t['u'], t['s']))
+
+        expected = [
+            ([0.0, 0.5, 1.0], [-3, -2, -1], [0, 1, 2], ['a'] * 3),
+            ([], [], [], []),
+            ([0.0, 0.5, 1.0, 1.5, 2.0], [-5, -4, -3, -2, -1], [0, 1, 2, 3, 4], ['a'] * 5),
+        ]
+        tester = Tester(topo)
+        tester.contents(types, [('memoryview', 'd', 'i', 'list')] * 3)
+        tester.contents(v, expected)
+        tester.test(self.test_ctxtype, self.test_config)
+
 import shutil
 import uuid
 import subprocess
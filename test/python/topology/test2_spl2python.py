@@ -130,6 +130,22 @@ class TestSPL2Python(unittest.TestCase):
         tester.contents(f, [{'i':0}, {'i':1}, {'i':None}])
         tester.test(self.test_ctxtype, self.test_config)
 
+    def test_wide_schema(self):
+        """Test a wide schema is passed correctly as a dict
+        """
+        n = 64
+        schema = 'tuple<' + ', '.join(['int32 a' + str(i) for i in range(n)]) + '>'
+        topo = Topology('test_wide_schema')
+        b = op.Source(topo, "spl.utility::Beacon", schema,
+            params = {'iterations':10})
+        for i in range(n):
+            setattr(b, 'a' + str(i), b.output('(int32) IterationCount() + ' + str(i)))
+        s = b.stream
+        f = s.map(lambda tuple : (len(tuple), tuple['a0'], tuple['a' + str(n-1)]))
+        tester = Tester(topo)
+        tester.contents(f, [(n, i, i + n - 1) for i in range(10)])
+        tester.test(self.test_ctxtype, self.test_config)
+
 class TestDistributedSPL(TestSPL2Python):
     def setUp(self):
         Tester.setup_distributed(self)
@@ -0,0 +1,74 @@
+# Licensed Materials - Property of IBM
+# Copyright IBM Corp. 2018
+import unittest
+import sys
+
+from streamsx.topology.topology import *
+from streamsx.topology.tester import Tester
+
+class TestSubinterpreterArgs(unittest.TestCase):
+    """ Validation of sub-interpreter arguments.
+    """
+    def test_params(self):
+        topo = Topology()
+        s = topo.source(range(10)).set_subinterpreter()
+        self.assertTrue(s.oport.operator.params['subinterpreter'])
+        m = s.map(lambda x : x).set_subinterpreter()
+        self.assertTrue(m.oport.operator.params['subinterpreter'])
+        f = m.filter(lambda x : True).set_subinterpreter()
+        self.assertTrue(f.oport.operator.params['subinterpreter'])
+        fm = f.flat_map(lambda x : [x])
+        self.assertNotIn('subinterpreter', fm.oport.operator.params)
+
+    def test_bad_stream(self):
+        topo = Topology()
+        s = topo.source(range(10))
+        self.assertRaises(TypeError, s.last(3).aggregate(len).set_subinterpreter)
+        self.assertRaises(TypeError, s.union({s.map(lambda x : x)}).set_subinterpreter)
+
+def _mark_interpreter(v):
+    sys._streamsx_test_mark = v
+    return v
+
+def _check_interpreter(v):
+    if hasattr(sys, '_streamsx_test_mark'):
+        raise AssertionError("Sub-interpreter state visible: " + str(v))
+    return v
+
+class TestSubinterpreter(unittest.TestCase):
+    _multiprocess_can_split_ = True
+
+    def setUp(self):
+        Tester.setup_standalone(self)
+
+    def test_Subinterpreter(self):
+        topo = Topology()
+        s = topo.source(range(30))
+        s = s.map(_mark_interpreter).set_subinterpreter()
+        s = s.filter(lambda x : x % 3 != 0).set_subinterpreter()
+        s = s.map(_check_interpreter)
+
+        tester = Tester(topo)
+        tester.contents(s, [x for x in range(30) if x % 3 != 0])
+        tester.test(self.test_ctxtype, self.test_config)
+
+    def test_SubinterpreterChannels(self):
+        # Channels of the same operator, each in its own
+        # sub-interpreter, converting a low-cardinality rstring
+        # attribute that the main interpreter would cache.
+        codes = [u'US', u'UK', u'FR', u'DE', u'Ü']
+        n = 3000
+        topo = Topology()
+        s = topo.source(range(n))
+        s = s.map(lambda x : (codes[x % len(codes)], x), schema='tuple<rstring c, int32 n>')
+        s = s.parallel(2)
+        s = s.map(lambda t : t['c'] + str(t['n'])).set_subinterpreter()
+        s = s.end_parallel()
+
+        tester = Tester(topo)
+        tester.contents(s, [codes[x % len(codes)] + str(x) for x in range(n)], ordered=False)
+        tester.test(self.test_ctxtype, self.test_config)
+
+class TestDistributedSubinterpreter(TestSubinterpreter):
+    def setUp(self):
+        Tester.setup_distributed(self)
@@ -0,0 +1,47 @@
+# Licensed Materials - Property of IBM
+# Copyright IBM Corp. 2018
+import unittest
+
+from streamsx.topology.topology import *
+from streamsx.topology.tester import Tester
+
+class TestSubmitQueueArgs(unittest.TestCase):
+    """ Validation of submit queue arguments.
+    """
+    def test_params(self):
+        topo = Topology()
+        s = topo.source(range(10))
+        m = s.map(lambda x : x).set_submit_queue(100)
+        self.assertEqual(100, m.oport.operator.params['submitQueue'])
+
+    def test_bad_size(self):
+        topo = Topology()
+        s = topo.source(range(10)).map(lambda x : x)
+        self.assertRaises(ValueError, s.set_submit_queue, 0)
+
+    def test_bad_stream(self):
+        topo = Topology()
+        s = topo.source(range(10))
+        self.assertRaises(TypeError, s.set_submit_queue, 10)
+        self.assertRaises(TypeError, s.filter(lambda x : True).set_submit_queue, 10)
+
+class TestSubmitQueue(unittest.TestCase):
+    _multiprocess_can_split_ = True
+
+    def setUp(self):
+        Tester.setup_standalone(self)
+
+    def test_SubmitQueue(self):
+        topo = Topology()
+        s = topo.source(range(500))
+        s = s.map(lambda x : x + 1).set_submit_queue(8)
+        s = s.map(lambda x : (x, x * 2), schema='tuple<int64 a, int64 b>').set_submit_queue(3)
+        s = s.map(lambda x : x['b'] - x['a'], batch_size=7).set_submit_queue(5)
+
+        tester = Tester(topo)
+        tester.contents(s, list(range(1, 501)))
+        tester.test(self.test_ctxtype, self.test_config)
+
+class TestDistributedSubmitQueue(TestSubmitQueue):
+    def setUp(self):
+        Tester.setup_distributed(self)
@@ -3,14 +3,32 @@
 # Copyright IBM Corp. 2017
 from __future__ import print_function
 import unittest
+import sys
 
 from streamsx.topology.topology import *
 from streamsx.topology.tester import Tester
+from streamsx.topology.schema import StreamSchema
 from streamsx.topology import context
 from streamsx.topology.context import ConfigParams
 from streamsx import rest
 import streamsx.ec as ec
 
+def _utf8_cached(v):
+    v.encode('utf-8')
+    # Creating a class named v caches its UTF-8 representation.
+    type(v, (object,), {})
+    return v
+
+class _SuppressEncodeError(object):
+    """Return each value as a tuple for an rstring attribute
+    suppressing values that cannot be encoded as UTF-8."""
+    def __call__(self, v):
+        return (v,)
+    def __enter__(self):
+        pass
+    def __exit__(self, exc_type, exc_value, traceback):
+        return exc_type is UnicodeEncodeError
+
 
 class TestUnicode(unittest.TestCase):
     _multiprocess_can_split_ = True
@@ -45,6 +63,87 @@ class TestUnicode(unittest.TestCase):
         tester.test(self.test_ctxtype, self.test_config)
         print(tester.result)
 
+    def test_structured_strings(self):
+        """ Test rstring attributes of structured streams
+            that are a mix of ASCII and non-ASCII values
+            passed into Python as dict and tuple styles.
+        """
+        topo = Topology()
+        ud = [u'', u'a', u'abcdefg', u'abcdefgh', u'abcdefghi',
+              u'abcdefghé', u'éabcdefghijklmnop', u'多язычных_abcdefghijk']
+        s = topo.source(ud)
+        st = s.map(lambda v : (v, len(v)), schema='tuple<rstring v, int32 n>')
+        sd = st.map(lambda t : (t['v'], t['n'] == len(t['v'])))
+        stt = st.map(lambda t : t, schema=StreamSchema('tuple<rstring v, int32 n>').as_tuple())
+        stt = stt.map(lambda t : (t[0], t[1] == len(t[0])))
+
+        tester = Tester(topo)
+        tester.contents(sd, [(v, True) for v in ud])
+        tester.contents(stt, [(v, True) for v in ud])
+        tester.test(self.test_ctxtype, self.test_config)
+
+    def test_repeated_strings(self):
+        """ Test rstring attributes with a small number
+            of distinct values that are repeated, as Python
+            strings are reused for such values.
+        """
+        topo = Topology()
+        codes = [u'US', u'UK', u'FR', u'DE', u'', u'Ü', u'a code longer than sixteen bytes']
+        ud = [codes[i % len(codes)] for i in range(3000)]
+        s = topo.source(ud)
+        st = s.map(lambda v : (v, v), schema='tuple<rstring c, rstring d>')
+        st = st.map(lambda t : t['c'] + '/' + t['d'])
+
+        tester = Tester(topo)
+        tester.contents(st, [v + '/' + v for v in ud])
+        tester.test(self.test_ctxtype, self.test_config)
+
+    def test_rstring_kinds(self):
+        """ Test conversion to rstring attributes of strings
+            of each Python string kind, with lengths either
+            side of those encoded directly into the rstring.
+        """
+        topo = Topology()
+        ud = [c * n for c in [u'a', u'é', u'中', u'😀'] for n in [1, 16, 63, 64, 65]]
+        ud.append(u'aé中😀' * 16)
+        ud.append(u'aé中😀' * 17)
+        s = topo.source(ud)
+        st = s.map(lambda v : (v,), schema='tuple<rstring v>')
+        st = st.map(lambda t : t['v'])
+
+        tester = Tester(topo)
+        tester.contents(st, ud)
+        tester.test(self.test_ctxtype, self.test_config)
+
+    def test_rstring_utf8_cached(self):
+        """ Test conversion to rstring attributes of strings
+            whose UTF-8 representation is cached by Python.
+        """
+        topo = Topology()
+        ud = [u'é', u'abcdé', u'中文', u'😀', u'多язычных_abcdefghijk' * 4]
+        s = topo.source(ud)
+        st = s.map(lambda v : (_utf8_cached(v),), schema='tuple<rstring v>')
+        st = st.map(lambda t : t['v'])
+
+        tester = Tester(topo)
+        tester.contents(st, ud)
+        tester.test(self.test_ctxtype, self.test_config)
+
+    def test_rstring_lone_surrogate(self):
+        """ Test a string with a lone surrogate raises
+            UnicodeEncodeError converting it to an rstring.
+        """
+        if sys.version_info.major == 2:
+            return self.skipTest("Python 2 encodes lone surrogates.")
+        topo = Topology()
+        s = topo.source([u'a', u'\ud800', u'é\udc00', u'中'])
+        st = s.map(_SuppressEncodeError(), schema='tuple<rstring v>')
+        st = st.map(lambda t : t['v'])
+
+        tester = Tester(topo)
+        tester.contents(st, [u'a', u'中'])
+        tester.test(self.test_ctxtype, self.test_config)
+
     def test_view_name(self):
         """
         Test view names that are unicode.
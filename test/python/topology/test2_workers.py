@@ -0,0 +1,159 @@
+# Licensed Materials - Property of IBM
+# Copyright IBM Corp. 2018
+import unittest
+import os
+import tempfile
+
+from streamsx.topology.topology import *
+from streamsx.topology.tester import Tester
+
+class TestWorkersArgs(unittest.TestCase):
+    """ Validation of worker process arguments.
+    """
+    def test_params(self):
+        topo = Topology()
+        s = topo.source(range(10))
+        m = s.map(lambda x : x, batch_size=10).set_workers(4)
+        self.assertEqual(4, m.oport.operator.params['workers'])
+        f = m.filter(lambda x : True, batch_size=5).set_workers(2)
+        self.assertEqual(2, f.oport.operator.params['workers'])
+
+    def test_bad_count(self):
+        topo = Topology()
+        s = topo.source(range(10)).map(lambda x : x, batch_size=10)
+        self.assertRaises(ValueError, s.set_workers, 0)
+
+    def test_bad_stream(self):
+        topo = Topology()
+        s = topo.source(range(10))
+        self.assertRaises(TypeError, s.set_workers, 2)
+        self.assertRaises(TypeError, s.map(lambda x : x).set_workers, 2)
+        self.assertRaises(TypeError, s.flat_map(lambda x : [x]).set_workers, 2)
+
+def _worker_square(v):
+    if v == 3:
+        raise ValueError(v)
+    return v * v
+
+class TestWorkerPool(unittest.TestCase):
+    """ Test a pool of worker processes outside of Streams.
+    """
+    def setUp(self):
+        import streamsx.topology.runtime as rt
+        self.rt = rt
+        self.pool = rt._WorkerPool(2, __name__, '_worker_square', None, 'object_in__object_out', None)
+
+    def tearDown(self):
+        self.pool.close()
+
+    def test_call(self):
+        batch = [(i,) for i in range(20) if i != 3]
+        rvs = []
+        self.rt._call_workers(self.pool, batch, rvs)
+        self.assertEqual([i * i for i in range(20) if i != 3], rvs)
+        mask = bytearray()
+        self.rt._filter_workers(self.pool, [(0,), (1,), (2,)], mask)
+        self.assertEqual(bytearray([0, 1, 1]), mask)
+
+    def test_exception(self):
+        batch = [(i,) for i in range(7)]
+        rvs = []
+        self.assertRaises(ValueError, self.rt._call_workers, self.pool, batch, rvs)
+        self.assertEqual([0, 1, 4], rvs)
+        # Suppressed exception, continue after the failing tuple
+        rvs.append(None)
+        self.rt._call_workers(self.pool, batch, rvs)
+        self.assertEqual([0, 1, 4, None, 16, 25, 36], rvs)
+
+# Exits the worker process for 5, for other values
+# the first time they are seen if STREAMSX_TEST_EXIT_ONCE
+# names a file that does not exist.
+def _worker_exit(v):
+    if v == 5:
+        os._exit(3)
+    once = os.environ.get('STREAMSX_TEST_EXIT_ONCE')
+    if once and v == 12 and not os.path.exists(once):
+        open(once, 'w').close()
+        os._exit(4)
+    return v
+
+def _worker_ec(v):
+    import streamsx.ec
+    try:
+        streamsx.ec.job_id()
+    except NotImplementedError as e:
+        return str(e)
+    return None
+
+class TestWorkerPoolExit(unittest.TestCase):
+    """ Test replacement of worker processes that exit.
+    """
+    def setUp(self):
+        import streamsx.topology.runtime as rt
+        self.rt = rt
+        self.dir = tempfile.mkdtemp()
+        os.environ['STREAMSX_TEST_EXIT_ONCE'] = os.path.join(self.dir, 'exited')
+        self.pool = rt._WorkerPool(3, __name__, '_worker_exit', None, 'object_in__object_out', None)
+        del os.environ['STREAMSX_TEST_EXIT_ONCE']
+
+    def tearDown(self):
+        self.pool.close()
+        import shutil
+        shutil.rmtree(self.dir)
+
+    def test_exit_once(self):
+        workers = list(self.pool._workers)
+        batch = [(i,) for i in range(6, 18)]
+        rvs = []
+        self.rt._call_workers(self.pool, batch, rvs)
+        self.assertEqual(list(range(6, 18)), rvs)
+        self.assertEqual(1, len(set(workers) - set(self.pool._workers)))
+
+        # Replaced worker continues with later batches
+        rvs = []
+        self.rt._call_workers(self.pool, batch, rvs)
+        self.assertEqual(list(range(6, 18)), rvs)
+
+    def test_exit_tuple(self):
+        batch = [(i,) for i in range(9)]
+        rvs = []
+        self.assertRaises(RuntimeError, self.rt._call_workers, self.pool, batch, rvs)
+        self.assertEqual([0, 1, 2, 3, 4], rvs)
+        # Suppressed exception, continue after the failing tuple
+        rvs.append(None)
+        self.rt._call_workers(self.pool, batch, rvs)
+        self.assertEqual([0, 1, 2, 3, 4, None, 6, 7, 8], rvs)
+
+        rvs = []
+        self.rt._call_workers(self.pool, [(i,) for i in range(20, 29)], rvs)
+        self.assertEqual(list(range(20, 29)), rvs)
+
+    def test_ec(self):
+        pool = self.rt._WorkerPool(1, __name__, '_worker_ec', None, 'object_in__object_out', None)
+        try:
+            rvs = []
+            self.rt._call_workers(pool, [(1,)], rvs)
+            self.assertIn('worker process', rvs[0])
+        finally:
+            pool.close()
+
+class TestWorkers(unittest.TestCase):
+    _multiprocess_can_split_ = True
+
+    def setUp(self):
+        Tester.setup_standalone(self)
+
+    def test_Workers(self):
+        topo = Topology()
+        s = topo.source(range(100))
+        s = s.map(lambda x : (x, os.getpid()), batch_size=10).set_workers(3)
+        s = s.filter(lambda x : x[1] != os.getpid(), batch_size=7).set_workers(2)
+        s = s.map(lambda x : x[0])
+
+        tester = Tester(topo)
+        tester.contents(s, list(range(100)))
+        tester.test(self.test_ctxtype, self.test_config)
+
+class TestDistributedWorkers(TestWorkers):
+    def setUp(self):
+        Tester.setup_distributed(self)
@@ -244,6 +244,33 @@ class TestSchema(unittest.TestCase):
         self.assertFalse(tv.alert)
         self.assertTrue(str(tv).startswith('StreamTuple('))
 
+    def test_buffers(self):
+        class _Op(object):
+            def __init__(self):
+                self.params = {}
+        s = _sch.StreamSchema('tuple<int32 a, list<float64> v>')
+        self.assertIs(s, s.with_buffers(False))
+        sb = s.with_buffers()
+        self.assertIsNot(s, sb)
+        self.assertEqual(s, sb)
+        self.assertIs(s.style, sb.style)
+        self.assertIs(sb, sb.with_buffers())
+        self.assertIs(tuple, sb.as_tuple().style)
+
+        op = _Op()
+        _sch.StreamSchema._fnop_style(sb, op, 'pyStyle')
+        self.assertEqual('dict;buffers', op.params['pyStyle'])
+        _sch.StreamSchema._fnop_style(sb.as_tuple(), op, 'pyStyle')
+        self.assertEqual('tuple;buffers', op.params['pyStyle'])
+        _sch.StreamSchema._fnop_style(sb.as_tuple(named='N'), op, 'pyStyle')
+        self.assertEqual('namedtuple:N;buffers', op.params['pyStyle'])
+        _sch.StreamSchema._fnop_style(sb.as_tuple().with_buffers(False), op, 'pyStyle')
+        self.assertEqual('tuple', op.params['pyStyle'])
+        _sch.StreamSchema._fnop_style(sb.as_view(), op, 'pyStyle')
+        self.assertEqual('view', op.params['pyStyle'])
+
+        self.assertIs(_sch.CommonSchema.Python.value, _sch.CommonSchema.Python.value.with_buffers())
+
     def test_get_namedtuple_make(self):
         sch = 'tuple<int32 b, rstring c>'
         cls = _str._get_namedtuple_cls(sch, 'MyTuple')